@@ -64,28 +64,26 @@
 
 #include <Adafruit_MS8607.h>
 
+static Adafruit_MS8607_ArduinoClock arduino_clock;
+
 /*!
  *    @brief  Instantiates a new MS8607 class
  */
-Adafruit_MS8607::Adafruit_MS8607(void) {}
-Adafruit_MS8607::~Adafruit_MS8607(void) {
-  if (temp_sensor) {
-    delete temp_sensor;
-  }
-  if (pressure_sensor) {
-    delete pressure_sensor;
-  }
-  if (humidity_sensor) {
-    delete humidity_sensor;
-  }
-  if (pt_i2c_dev) {
-    delete pt_i2c_dev;
-  }
-
-  if (hum_i2c_dev) {
-    delete hum_i2c_dev;
-  }
+Adafruit_MS8607::Adafruit_MS8607(void)
+#ifndef MS8607_NO_UNIFIED_SENSOR
+    : temp_sensor(this), pressure_sensor(this), humidity_sensor(this)
+#endif
+{
+  _clock = &arduino_clock;
+  _recovery_policy.retries = MS8607_RECOVERY_RETRIES;
+  _recovery_policy.backoff_us = MS8607_RECOVERY_BACKOFF_US;
+  _recovery_policy.reset_after = MS8607_RECOVERY_RESET_AFTER;
+  resetRecoveryCounters();
+#ifdef MS8607_ENABLE_STATS
+  resetStats();
+#endif
 }
+Adafruit_MS8607::~Adafruit_MS8607(void) { _release_transports(); }
 
 /*!
  *    @brief  Sets up the hardware and initializes I2C
@@ -96,28 +94,58 @@ Adafruit_MS8607::~Adafruit_MS8607(void) {
  *    @return True if initialization was successful, otherwise false.
  */
 bool Adafruit_MS8607::begin(TwoWire *wire, int32_t sensor_id) {
+  _release_transports();
 
-  if (pt_i2c_dev) {
-    delete pt_i2c_dev;
-  }
+  // built in place so that begin() can be called again without the heap
+  pt_i2c_dev = new (_pt_transport_storage)
+      Adafruit_MS8607_I2CTransport(MS8607_PT_ADDRESS, wire);
+  hum_i2c_dev = new (_hum_transport_storage)
+      Adafruit_MS8607_I2CTransport(MS8607_HUM_ADDRESS, wire);
+  _owns_transports = true;
 
-  if (hum_i2c_dev) {
-    delete hum_i2c_dev;
-  }
+  return _begin(sensor_id);
+}
+
+/*!
+ *    @brief  Sets up the sensor over caller-supplied bus interfaces, for
+ *            buses other than TwoWire. The transports are not deleted by
+ *            the driver and must outlive it
+ *    @param  pt_transport
+ *            The bus interface for the pressure & temperature sensor
+ *    @param  hum_transport
+ *            The bus interface for the humidity sensor
+ *    @param  sensor_id
+ *            The unique ID to differentiate the sensors from others
+ *    @return True if initialization was successful, otherwise false.
+ */
+bool Adafruit_MS8607::begin(Adafruit_MS8607_Transport *pt_transport,
+                            Adafruit_MS8607_Transport *hum_transport,
+                            int32_t sensor_id) {
+  _release_transports();
 
-  pt_i2c_dev = new Adafruit_I2CDevice(MS8607_PT_ADDRESS, wire);
-  hum_i2c_dev = new Adafruit_I2CDevice(MS8607_HUM_ADDRESS, wire);
+  pt_i2c_dev = pt_transport;
+  hum_i2c_dev = hum_transport;
 
-  if (!pt_i2c_dev->begin()) {
+  return _begin(sensor_id);
+}
+
+bool Adafruit_MS8607::_begin(int32_t sensor_id) {
+#ifdef MS8607_MONITOR
+  // route every transaction through the monitors
+  _pt_monitor.setTransport(pt_i2c_dev);
+  _hum_monitor.setTransport(hum_i2c_dev);
+  pt_i2c_dev = &_pt_monitor;
+  hum_i2c_dev = &_hum_monitor;
+#endif
+  if (!_check(pt_i2c_dev->begin()) || !_check(hum_i2c_dev->begin())) {
     return false;
   }
-  if (!hum_i2c_dev->begin()) {
+  // values read from a previous sensor or configuration must not be served
+  _pt_valid = false;
+  _humidity_valid = false;
+  if (!reset()) {
     return false;
   }
-  reset();
-  temp_sensor = new Adafruit_MS8607_Temp(this);
-  pressure_sensor = new Adafruit_MS8607_Pressure(this);
-  humidity_sensor = new Adafruit_MS8607_Humidity(this);
 
   return init(sensor_id);
 }
@@ -129,61 +157,59 @@ bool Adafruit_MS8607::begin(TwoWire *wire, int32_t sensor_id) {
  */
 bool Adafruit_MS8607::reset(void) {
   uint8_t cmd = P_T_RESET;
-  bool success = true;
-  success = pt_i2c_dev->write(&cmd, 1);
-  if (!success) {
+  if (!_transfer(pt_i2c_dev, &cmd, 1, NULL, 0)) {
     return false;
   }
 
   cmd = HSENSOR_RESET_COMMAND;
-  success = hum_i2c_dev->write(&cmd, 1);
-  if (!success) {
+  if (!_transfer(hum_i2c_dev, &cmd, 1, NULL, 0)) {
     return false;
   }
-  delay(15);
-
-  return true;
-}
-
-bool Adafruit_MS8607::_fetch_temp_calibration_values(void) {
-  uint8_t offset = 0;
-  uint16_t buffer[8];
-  uint8_t tmp_buffer[2];
-
-  for (int i = 0; i < 7; i++) {
-    offset = 2 * i;
-    tmp_buffer[0] = PROM_ADDRESS_READ_ADDRESS_0 + offset;
-    pt_i2c_dev->write_then_read(tmp_buffer, 1, tmp_buffer, 2);
-    buffer[i] = tmp_buffer[0] << 8;
-    buffer[i] |= tmp_buffer[1];
-  }
+  // a soft reset restores the default humidity resolution
+  _hum_resolution = MS8607_HUMIDITY_RESOLUTION_OSR_12b;
+  _wait(15000);
 
-  if (!_psensor_crc_check(buffer, (buffer[0] & 0xF000) >> 12)) {
-    return false;
-  }
-  press_sens = buffer[1];
-  press_offset = buffer[2];
-  press_sens_temp_coeff = buffer[3];
-  press_offset_temp_coeff = buffer[4];
-  ref_temp = buffer[5];
-  temp_temp_coeff = buffer[6];
   return true;
 }
 
 /*!  @brief Initializer for post i2c/spi init
- *   @param sensor_id Optional unique ID for the sensor set
+ *   @param sensor_id Optional unique ID for the sensor set. The temperature,
+ *   pressure and humidity sensors get this ID and the next two. If 0, the
+ *   IDs are derived from the serial number
  *   @returns True if chip identified and initialized
  */
 bool Adafruit_MS8607::init(int32_t sensor_id) {
-  (void)sensor_id;
-
-  if (!_fetch_temp_calibration_values()) {
+  // a serial number that cannot be read, because the transport cannot read
+  // it (MS8607_ERR_INVALID, like replays), the sensor does not answer or it
+  // arrives corrupted, leaves the default IDs. Only a bus error, which
+  // means the bus cannot be used at all, fails begin()
+  _serial_valid = _read_serial();
+  if (!_serial_valid && _status == MS8607_ERR_BUS) {
     return false;
   }
+  if (sensor_id == 0) {
+    // the unique SNB bytes, leaving room for the three sensors' offsets
+    sensor_id = _serial_valid
+                    ? (int32_t)((uint32_t)(_serial >> 16) & 0x1FFFFFFF) << 2
+                    : MS8607_DEFAULT_SENSOR_ID;
+  }
+  _sensorid_temp = sensor_id;
+  _sensorid_pressure = sensor_id + 1;
+  _sensorid_humidity = sensor_id + 2;
+
+  // a copy given to setCalibration() saves reading the PROM
+  if (!_calibration_cached) {
+    if (!_read_calibration()) {
+      return false;
+    }
+  }
   if (!enableHumidityClockStretching(false)) {
     return false;
   }
-  if (!setHumidityResolution(MS8607_HUMIDITY_RESOLUTION_OSR_12b)) {
+  // reset() leaves the humidity sensor at 12 bits, so the user register is
+  // only rewritten if the resolution was changed since
+  if (_hum_resolution != MS8607_HUMIDITY_RESOLUTION_OSR_12b &&
+      !setHumidityResolution(MS8607_HUMIDITY_RESOLUTION_OSR_12b)) {
     return false;
   }
   if (!setPressureResolution(MS8607_PRESSURE_RESOLUTION_OSR_4096)) {
@@ -193,14 +219,72 @@ bool Adafruit_MS8607::init(int32_t sensor_id) {
   return true;
 }
 
+/**
+ * @brief Get the humidity sensor's 64-bit serial number, as read and CRC
+ * checked by begin(). It identifies the part, e.g. to key saved calibrations
+ * or logs
+ *
+ * @param serial Where to copy the serial number
+ * @return true: success false: begin() could not read it
+ */
+bool Adafruit_MS8607::getSerialNumber(uint64_t *serial) {
+  if (!_serial_valid) {
+    return false;
+  }
+  *serial = _serial;
+  return true;
+}
+
+/**
+ * @brief Get a copy of the calibration constants, including their CRC, to
+ * store and pass to setCalibration() on a later start
+ *
+ * @param calibration Where to copy the calibration constants
+ * @return true: success false: the constants have not been read yet
+ */
+bool Adafruit_MS8607::getCalibration(ms8607_calibration_t *calibration) {
+  if (!_calibration_loaded) {
+    return false;
+  }
+  *calibration = _calibration;
+  return true;
+}
+
+/**
+ * @brief Use a stored copy of the calibration constants instead of reading
+ * them from the sensor's PROM in begin(). The copy must come from
+ * getCalibration() on the same sensor
+ *
+ * @param calibration The stored calibration constants, or NULL to read the
+ * PROM again
+ * @return true: success false: the copy failed its CRC check and was not used
+ */
+bool Adafruit_MS8607::setCalibration(const ms8607_calibration_t *calibration) {
+  _calibration_cached = false;
+  if (!calibration) {
+    return true;
+  }
+  if (!ms8607_check_calibration(calibration)) {
+    return false;
+  }
+  _calibration = *calibration;
+  _calibration_cached = true;
+  _calibration_loaded = true;
+  return true;
+}
+
 /**
  * @brief Get the currently set resolution for humidity readings
  *
- * @return ms8607_humidity_resolution_t the current resolution
+ * @return ms8607_humidity_resolution_t the current resolution, or the last
+ * one set if it could not be read
  */
 ms8607_humidity_resolution_t Adafruit_MS8607::getHumidityResolution(void) {
-  uint8_t reg_value = _read_humidity_user_register();
+  uint8_t reg_value;
 
+  if (!_read_humidity_user_register(&reg_value)) {
+    return _hum_resolution;
+  }
   return ((ms8607_humidity_resolution_t)(reg_value &
                                          HSENSOR_USER_REG_RESOLUTION_MASK));
 }
@@ -212,14 +296,22 @@ ms8607_humidity_resolution_t Adafruit_MS8607::getHumidityResolution(void) {
  */
 bool Adafruit_MS8607::setHumidityResolution(
     ms8607_humidity_resolution_t resolution) {
-  uint8_t reg_value = _read_humidity_user_register();
+  uint8_t reg_value;
+
+  if (!_read_humidity_user_register(&reg_value)) {
+    return false;
+  }
 
   // unset current value
   reg_value &= ~HSENSOR_USER_REG_RESOLUTION_MASK;
   // set new value
   reg_value |= resolution & HSENSOR_USER_REG_RESOLUTION_MASK;
 
-  return _write_humidity_user_register(reg_value);
+  if (!_write_humidity_user_register(reg_value)) {
+    return false;
+  }
+  _hum_resolution = resolution;
+  return true;
 }
 /**
  * @brief Get the currently set resolution for pressure readings
@@ -244,7 +336,9 @@ bool Adafruit_MS8607::setPressureResolution(
 
 /**
  * @brief Allow the MS8607 to hold the clock line low until it completes the
- * requested measurements
+ * requested measurements. Blocking humidity reads then finish as soon as the
+ * conversion does, but the bus is unavailable while it converts and the I2C
+ * controller must tolerate long clock stretches
  *
  * @param enable_stretching true: enable
  * @return true: success false: failure
@@ -258,6 +352,127 @@ bool Adafruit_MS8607::enableHumidityClockStretching(bool enable_stretching) {
   return true;
 }
 
+/**
+ * @brief Poll for the end of no-hold humidity conversions rather than
+ * waiting for the worst-case conversion time. The sensor does not
+ * acknowledge reads until the conversion is done, so a short read is tried
+ * every `interval_us` until one succeeds
+ *
+ * @param interval_us Time between read attempts in microseconds, or 0 to
+ * disable polling and wait a fixed time
+ * @param timeout_us The longest time to poll before giving up, in
+ * microseconds
+ */
+void Adafruit_MS8607::setHumidityPolling(uint32_t interval_us,
+                                         uint32_t timeout_us) {
+  _hum_poll_interval_us = interval_us;
+  _hum_poll_timeout_us = timeout_us;
+}
+
+/**
+ * @brief Set the time source used for timestamps and conversion waits
+ *
+ * @param clock The clock to use, or NULL to restore the Arduino timing
+ * functions
+ */
+void Adafruit_MS8607::setClock(Adafruit_MS8607_Clock *clock) {
+  _clock = clock ? clock : &arduino_clock;
+}
+
+/**
+ * @brief Get the time source used for timestamps and conversion waits
+ *
+ * @return Adafruit_MS8607_Clock* the current clock
+ */
+Adafruit_MS8607_Clock *Adafruit_MS8607::getClock(void) { return _clock; }
+
+/**
+ * @brief Set a function to call repeatedly while waiting for conversions
+ * instead of delaying, so other work can be done while the sensor converts.
+ * The callback should return promptly; the wait ends at the first return
+ * after the conversion time has passed. If the clock has not moved when the
+ * callback returns, the driver delays for up to MS8607_YIELD_STEP_US before
+ * calling it again, so waits also end on a virtual clock
+ *
+ * @param callback The function to call, or NULL to delay normally
+ * @param context A pointer passed to each call of the callback
+ */
+void Adafruit_MS8607::setYieldCallback(ms8607_yield_callback_t callback,
+                                       void *context) {
+  _yield_callback = callback;
+  _yield_context = context;
+}
+
+/**
+ * @brief Read pressure, temperature and optionally humidity. The results are
+ * available from getTemperatureX100() and the other getters. Values younger
+ * than setMaxSampleAge() are kept without reading the sensor
+ *
+ * @param read_humidity true: read humidity as well
+ * @return true: success false: failure
+ */
+bool Adafruit_MS8607::read(bool read_humidity) {
+  return _update(read_humidity);
+}
+
+/**
+ * @brief Let read() and getEvent() serve the last good values without
+ * reading the sensor while they are younger than a maximum age. Events are
+ * stamped with when their values were measured, not when they were served
+ *
+ * @param max_age_ms The maximum age in milliseconds, or 0 to always read
+ */
+void Adafruit_MS8607::setMaxSampleAge(uint32_t max_age_ms) {
+  _max_age_ms = max_age_ms;
+}
+
+/**
+ * @brief Set how the driver recovers from failures. A failed transaction is
+ * tried again up to `retries` times, waiting `backoff_us` before the first
+ * retry and twice as long before each one after. When `reset_after` reads
+ * in a row have failed, the sensor is soft reset, its humidity resolution
+ * restored and the read tried once more. The calibration is only read
+ * from the PROM again if the copy in memory fails its CRC check. Retries
+ * apply to the split conversion methods too, which then wait while backing
+ * off
+ *
+ * @param policy The recovery policy
+ */
+void Adafruit_MS8607::setRecoveryPolicy(
+    const ms8607_recovery_policy_t *policy) {
+  _recovery_policy = *policy;
+  _failed_reads = 0;
+}
+
+/**
+ * @brief Get how often each level of recovery was needed
+ *
+ * @param counters Where to copy the counters
+ */
+void Adafruit_MS8607::getRecoveryCounters(
+    ms8607_recovery_counters_t *counters) {
+  *counters = _recovery_counters;
+}
+
+/**
+ * @brief Clear the recovery counters
+ *
+ */
+void Adafruit_MS8607::resetRecoveryCounters(void) {
+  memset(&_recovery_counters, 0, sizeof(_recovery_counters));
+}
+
+/**
+ * @brief Get the result of the most recent bus transaction or check of the
+ * data read. After a call that returned false, this tells why it failed,
+ * e.g. MS8607_ERR_CRC for corrupt data or MS8607_ERR_TIMEOUT for a humidity
+ * conversion that did not finish while polling
+ *
+ * @return ms8607_status_t MS8607_OK if the last operation succeeded
+ */
+ms8607_status_t Adafruit_MS8607::getStatus(void) { return _status; }
+
+#ifndef MS8607_NO_UNIFIED_SENSOR
 /**************************************************************************/
 /*!
     @brief  Gets the humidity sensor and temperature values as sensor events
@@ -266,23 +481,23 @@ bool Adafruit_MS8607::enableHumidityClockStretching(bool enable_stretching) {
     @param  temp Sensor event object that will be populated with temp data
     @param  humidity Sensor event object that will be populated with humidity
    data
-    @returns true if the event data was read successfully
+    @returns true if the event data was read successfully. On failure the
+   events are left untouched and getStatus() gives the reason
 */
 /**************************************************************************/
 bool Adafruit_MS8607::getEvent(sensors_event_t *pressure, sensors_event_t *temp,
                                sensors_event_t *humidity) {
-  uint32_t t = millis();
+  if (!_update(humidity != NULL)) {
+    return false;
+  }
 
-  _read();
-  // use helpers to fill in the events
+  // each event is stamped with when its quantity was measured
   if (temp)
-    fillTempEvent(temp, t);
+    fillTempEvent(temp, _temperature_ms);
   if (pressure)
-    fillPressureEvent(pressure, t);
-  if (humidity) {
-    _read_humidity();
-    fillHumidityEvent(humidity, t);
-  }
+    fillPressureEvent(pressure, _pressure_ms);
+  if (humidity)
+    fillHumidityEvent(humidity, _humidity_ms);
   return true;
 }
 
@@ -299,7 +514,7 @@ void Adafruit_MS8607_Temp::getSensor(sensor_t *sensor) {
   strncpy(sensor->name, "MS8607_T", sizeof(sensor->name) - 1);
   sensor->name[sizeof(sensor->name) - 1] = 0;
   sensor->version = 1;
-  sensor->sensor_id = _sensorID;
+  sensor->sensor_id = _theMS8607->_sensorid_temp;
   sensor->type = SENSOR_TYPE_AMBIENT_TEMPERATURE;
   sensor->min_delay = 0;
   sensor->min_value = -40;
@@ -320,7 +535,7 @@ void Adafruit_MS8607_Pressure::getSensor(sensor_t *sensor) {
   strncpy(sensor->name, "MS8607_P", sizeof(sensor->name) - 1);
   sensor->name[sizeof(sensor->name) - 1] = 0;
   sensor->version = 1;
-  sensor->sensor_id = _sensorID;
+  sensor->sensor_id = _theMS8607->_sensorid_pressure;
   sensor->type = SENSOR_TYPE_PRESSURE;
   sensor->min_delay = 0;
   sensor->min_value = 10;
@@ -341,7 +556,7 @@ void Adafruit_MS8607_Humidity::getSensor(sensor_t *sensor) {
   strncpy(sensor->name, "MS8607_H", sizeof(sensor->name) - 1);
   sensor->name[sizeof(sensor->name) - 1] = 0;
   sensor->version = 1;
-  sensor->sensor_id = _sensorID;
+  sensor->sensor_id = _theMS8607->_sensorid_humidity;
   sensor->type = SENSOR_TYPE_RELATIVE_HUMIDITY;
   sensor->min_delay = 0;
   sensor->min_value = 0;
@@ -351,155 +566,415 @@ void Adafruit_MS8607_Humidity::getSensor(sensor_t *sensor) {
 /*!
     @brief  Gets the temperature as a standard sensor event
     @param  event Sensor event object that will be populated
-    @returns true
+    @returns true if the event data was read successfully
 */
 bool Adafruit_MS8607_Temp::getEvent(sensors_event_t *event) {
-  _theMS8607->getEvent(NULL, event, NULL);
-
-  return true;
+  return _theMS8607->getEvent(NULL, event, NULL);
 }
 /*!
     @brief  Gets the pressure as a standard sensor event
     @param  event Sensor event object that will be populated
-    @returns true
+    @returns true if the event data was read successfully
 */
 bool Adafruit_MS8607_Pressure::getEvent(sensors_event_t *event) {
-  _theMS8607->getEvent(event, NULL, NULL);
-
-  return true;
+  return _theMS8607->getEvent(event, NULL, NULL);
 }
 /*!
     @brief  Gets the relative humidity as a standard sensor event
     @param  event Sensor event object that will be populated
-    @returns true
+    @returns true if the event data was read successfully
 */
 bool Adafruit_MS8607_Humidity::getEvent(sensors_event_t *event) {
-  _theMS8607->getEvent(NULL, NULL, event);
-
-  return true;
+  return _theMS8607->getEvent(NULL, NULL, event);
 }
+#endif
+
 /**
  * @brief Read the current pressure and temperature
  *
  * @return true: success false: failure
  */
 bool Adafruit_MS8607::_read(void) {
-
-  uint8_t cmd;
-  bool status = true;
-  uint8_t buffer[3];
-
   uint32_t raw_temp, raw_pressure;
 
   // First read temperature
-  cmd = psensor_resolution_osr * 2;
-  cmd |= PSENSOR_START_TEMPERATURE_ADC_CONVERSION;
-  status = pt_i2c_dev->write(&cmd, 1);
-  if (!status) {
-    return status;
+  if (!startTemperatureConversion()) {
+    return false;
   }
-
-  delay(18);
-
-  buffer[0] = PSENSOR_READ_ADC;
-  status = pt_i2c_dev->write_then_read(buffer, 1, buffer, 3);
-  if (!status) {
-    return status;
+  _wait(getPTConversionTime());
+  if (!readPTConversion(&raw_temp)) {
+    return false;
   }
-  raw_temp =
-      ((uint32_t)buffer[0] << 16) | ((uint32_t)buffer[1] << 8) | buffer[2];
 
   // Now read pressure
-  cmd = psensor_resolution_osr * 2;
-  cmd |= PSENSOR_START_PRESSURE_ADC_CONVERSION;
-  status = pt_i2c_dev->write(&cmd, 1);
-  delay(18);
+  if (!startPressureConversion()) {
+    return false;
+  }
+  _wait(getPTConversionTime());
+  if (!readPTConversion(&raw_pressure)) {
+    return false;
+  }
 
-  buffer[0] = PSENSOR_READ_ADC;
-  status = pt_i2c_dev->write_then_read(buffer, 1, buffer, 3);
+  return computePressureTemperature(raw_temp, raw_pressure);
+}
 
-  raw_pressure =
-      ((uint32_t)buffer[0] << 16) | ((uint32_t)buffer[1] << 8) | buffer[2];
+/*
+humidity user register value: 0b10
+humidity resolution raw value: 0x0
+Temperature: 29.85 degrees C
+Pressure: 1008.94 hPa
+Relative Humidity: 25.94 %rH
+*/
+bool Adafruit_MS8607::_read_humidity(void) {
+  uint8_t buffer[3];
+  uint16_t raw_hum;
+
+  if (_hum_sensor_i2c_read_mode == MS8607_I2C_HOLD) {
+    // the sensor holds SCL low until the conversion is done, so the read
+    // completes as soon as the result is ready
+    buffer[0] = HSENSOR_READ_HUMIDITY_W_HOLD_COMMAND;
+    uint32_t start_us = _clock->micros();
+    if (!_transfer(hum_i2c_dev, buffer, 1, buffer, 3) ||
+        !_parse_humidity(buffer, &raw_hum)) {
+      return false;
+    }
+    _humidity_us = _midpoint(start_us, _clock->micros(),
+                             getHumidityConversionTime());
+    return computeHumidity(raw_hum);
+  }
 
-  return _applyPTCorrections(raw_temp, raw_pressure);
+  if (!startHumidityConversion()) {
+    return false;
+  }
+  if (_hum_poll_interval_us) {
+    // the sensor NACKs reads until the conversion is done
+    uint32_t start = _clock->micros();
+    do {
+      _wait(_hum_poll_interval_us);
+      uint32_t end_us = _clock->micros();
+      ms8607_status_t status = hum_i2c_dev->read(buffer, 3);
+      if (status == MS8607_OK) {
+        if (!_parse_humidity(buffer, &raw_hum)) {
+          return false;
+        }
+        _humidity_us =
+            _midpoint(_hum_start_us, end_us, getHumidityConversionTime());
+        return computeHumidity(raw_hum);
+      }
+      if (status != MS8607_ERR_NACK) {
+        // anything but a NACK is a bus fault, not a conversion in progress
+        return _check(status);
+      }
+    } while (_clock->micros() - start < _hum_poll_timeout_us);
+    // the reads were NACKed until the time ran out
+    _status = MS8607_ERR_TIMEOUT;
+    return false;
+  }
+  _wait(20000);
+  if (!readHumidityConversion(&raw_hum)) {
+    return false;
+  }
+  return computeHumidity(raw_hum);
 }
 
-bool Adafruit_MS8607::_applyPTCorrections(int32_t raw_temp,
-                                          int32_t raw_pressure) {
-  int32_t dT, TEMP;
-  int64_t OFF, SENS, P, T2, OFF2, SENS2;
-  dT = (int32_t)raw_temp - ((int32_t)ref_temp << 8);
+/********************* Non-blocking Methods **********************************/
+/**
+ * @brief Start a temperature (D2) conversion. The result can be fetched with
+ * readPTConversion() once getPTConversionTime() microseconds have passed
+ *
+ * @return true: success false: failure
+ */
+bool Adafruit_MS8607::startTemperatureConversion(void) {
+  uint8_t cmd = psensor_resolution_osr * 2;
+  cmd |= PSENSOR_START_TEMPERATURE_ADC_CONVERSION;
+  return _startPTConversion(cmd);
+}
 
-  // Actual temperature = 2000 + dT * TEMPSENS
-  TEMP = 2000 + ((int64_t)dT * (int64_t)temp_temp_coeff >> 23);
+/**
+ * @brief Start a pressure (D1) conversion. The result can be fetched with
+ * readPTConversion() once getPTConversionTime() microseconds have passed
+ *
+ * @return true: success false: failure
+ */
+bool Adafruit_MS8607::startPressureConversion(void) {
+  uint8_t cmd = psensor_resolution_osr * 2;
+  cmd |= PSENSOR_START_PRESSURE_ADC_CONVERSION;
+  return _startPTConversion(cmd);
+}
 
-  // Second order temperature compensation
-  if (TEMP < 2000) {
-    T2 = (3 * ((int64_t)dT * (int64_t)dT)) >> 33;
-    OFF2 = 61 * ((int64_t)TEMP - 2000) * ((int64_t)TEMP - 2000) / 16;
-    SENS2 = 29 * ((int64_t)TEMP - 2000) * ((int64_t)TEMP - 2000) / 16;
+/**
+ * @brief Read the ADC result of the last pressure or temperature conversion
+ *
+ * @param raw Pointer to where the 24-bit raw ADC value will be stored
+ * @return true: success false: failure, including a result of 0, which the
+ * sensor gives when it has no result to read
+ */
+bool Adafruit_MS8607::readPTConversion(uint32_t *raw) {
+  uint8_t buffer[3];
+  uint32_t end_us = _clock->micros();
 
-    if (TEMP < -1500) {
-      OFF2 += 17 * ((int64_t)TEMP + 1500) * ((int64_t)TEMP + 1500);
-      SENS2 += 9 * ((int64_t)TEMP + 1500) * ((int64_t)TEMP + 1500);
-    }
+  buffer[0] = PSENSOR_READ_ADC;
+  if (!_transfer(pt_i2c_dev, buffer, 1, buffer, 3)) {
+    return false;
+  }
+  *raw = ((uint32_t)buffer[0] << 16) | ((uint32_t)buffer[1] << 8) | buffer[2];
+  if (*raw == 0) {
+    // the sensor returns 0 once the result has been read, so this is a
+    // retry after the data of a failed attempt was lost, or a read with
+    // no conversion started
+    _status = MS8607_ERR_BUS;
+    return false;
+  }
+  if (_pt_temperature) {
+    _temperature_us = _midpoint(_pt_start_us, end_us, getPTConversionTime());
   } else {
-    T2 = (5 * ((int64_t)dT * (int64_t)dT)) >> 38;
-    OFF2 = 0;
-    SENS2 = 0;
+    _pressure_us = _midpoint(_pt_start_us, end_us, getPTConversionTime());
+  }
+  return true;
+}
+
+/**
+ * @brief Start a humidity conversion without holding the I2C clock,
+ * regardless of enableHumidityClockStretching(). The result can be fetched
+ * with readHumidityConversion() once getHumidityConversionTime() microseconds
+ * have passed
+ *
+ * @return true: success false: failure
+ */
+bool Adafruit_MS8607::startHumidityConversion(void) {
+  uint8_t cmd = MS8607_I2C_NO_HOLD;
+  if (!_transfer(hum_i2c_dev, &cmd, 1, NULL, 0)) {
+    return false;
   }
+  _hum_start_us = _clock->micros();
+  return true;
+}
 
-  // OFF = OFF_T1 + TCO * dT
-  OFF = ((int64_t)(press_offset) << 17) +
-        (((int64_t)press_offset_temp_coeff * dT) >> 6);
-  OFF -= OFF2;
+/**
+ * @brief Read and CRC check the result of the last humidity conversion
+ *
+ * @param raw Pointer to where the 16-bit raw humidity value will be stored
+ * @return true: success false: failure
+ */
+bool Adafruit_MS8607::readHumidityConversion(uint16_t *raw) {
+  uint8_t buffer[3];
+  uint32_t end_us = _clock->micros();
 
-  // Sensitivity at actual temperature = SENS_T1 + TCS * dT
-  SENS = ((int64_t)press_sens << 16) +
-         (((int64_t)press_sens_temp_coeff * dT) >> 7);
-  SENS -= SENS2;
+  if (!_transfer(hum_i2c_dev, NULL, 0, buffer, 3) ||
+      !_parse_humidity(buffer, raw)) {
+    return false;
+  }
+  _humidity_us =
+      _midpoint(_hum_start_us, end_us, getHumidityConversionTime());
+  return true;
+}
 
-  // Temperature compensated pressure = D1 * SENS - OFF
-  P = (((raw_pressure * SENS) >> 21) - OFF) >> 15;
+/**
+ * @brief Get the maximum time a pressure or temperature conversion takes at
+ * the current pressure resolution
+ *
+ * @return uint32_t the conversion time in microseconds
+ */
+uint32_t Adafruit_MS8607::getPTConversionTime(void) {
+  switch (psensor_resolution_osr) {
+  case MS8607_PRESSURE_RESOLUTION_OSR_256:
+    return PSENSOR_CONVERSION_TIME_OSR_256;
+  case MS8607_PRESSURE_RESOLUTION_OSR_512:
+    return PSENSOR_CONVERSION_TIME_OSR_512;
+  case MS8607_PRESSURE_RESOLUTION_OSR_1024:
+    return PSENSOR_CONVERSION_TIME_OSR_1024;
+  case MS8607_PRESSURE_RESOLUTION_OSR_2048:
+    return PSENSOR_CONVERSION_TIME_OSR_2048;
+  case MS8607_PRESSURE_RESOLUTION_OSR_4096:
+    return PSENSOR_CONVERSION_TIME_OSR_4096;
+  default:
+    return PSENSOR_CONVERSION_TIME_OSR_8192;
+  }
+}
 
-  _temperature = ((float)TEMP - T2) / 100;
-  _pressure = (float)P / 100;
+/**
+ * @brief Get the maximum time a humidity conversion takes at the current
+ * humidity resolution
+ *
+ * @return uint32_t the conversion time in microseconds
+ */
+uint32_t Adafruit_MS8607::getHumidityConversionTime(void) {
+  switch (_hum_resolution) {
+  case MS8607_HUMIDITY_RESOLUTION_OSR_8b:
+    return HSENSOR_CONVERSION_TIME_8b * 1000UL;
+  case MS8607_HUMIDITY_RESOLUTION_OSR_10b:
+    return HSENSOR_CONVERSION_TIME_10b * 1000UL;
+  case MS8607_HUMIDITY_RESOLUTION_OSR_11b:
+    return HSENSOR_CONVERSION_TIME_11b * 1000UL;
+  default:
+    return HSENSOR_CONVERSION_TIME_12b * 1000UL;
+  }
+}
 
+/**
+ * @brief Compensate raw temperature and pressure ADC values using the
+ * calibration constants, updating the current measurements
+ *
+ * @param raw_temp The raw temperature (D2) value
+ * @param raw_pressure The raw pressure (D1) value
+ * @return true: success false: failure
+ */
+bool Adafruit_MS8607::computePressureTemperature(uint32_t raw_temp,
+                                                 uint32_t raw_pressure) {
+#ifdef MS8607_ENABLE_CAPTURE
+  if (_capture) {
+    // held back to the end of the read, so humidity read with them is
+    // written in the same record
+    _capture_flush();
+    _capture_pt = true;
+    _capture_time_us = _clock->micros();
+    _capture_raw_temp = raw_temp;
+    _capture_raw_pressure = raw_pressure;
+  }
+#endif
+  ms8607_compensate_pt(&_calibration, raw_temp, raw_pressure, &_temperature,
+                       &_pressure);
+  _temperature_ms = _to_millis(_temperature_us);
+  _pressure_ms = _to_millis(_pressure_us);
+  _pt_valid = true;
   return true;
 }
-/*
-humidity user register value: 0b10
-humidity resolution raw value: 0x0
-Temperature: 29.85 degrees C
-Pressure: 1008.94 hPa
-Relative Humidity: 25.94 %rH
-*/
-bool Adafruit_MS8607::_read_humidity(void) {
-  uint8_t buffer[3];
-  getHumidityResolution();
-  buffer[0] = MS8607_I2C_NO_HOLD;
-  // self._buffer[0] = _MS8607_HUM_CMD_READ_NO_HOLD
-  hum_i2c_dev->write(buffer, 1);
-  delay(20);
-  hum_i2c_dev->read(buffer, 3);
 
-  uint16_t raw_hum = buffer[0] << 8 | buffer[1];
-  uint8_t crc = buffer[2];
-  if (!_hsensor_crc_check(raw_hum, crc)) {
-    return false;
+/**
+ * @brief Convert a raw humidity value, updating the current measurement
+ *
+ * @param raw_humidity The raw humidity value
+ * @return true: success false: failure
+ */
+bool Adafruit_MS8607::computeHumidity(uint16_t raw_humidity) {
+#ifdef MS8607_ENABLE_CAPTURE
+  if (_capture && _capture_pt) {
+    ms8607_capture_pt_humidity(_capture, _capture_time_us, _capture_raw_temp,
+                               _capture_raw_pressure, _clock->micros(),
+                               raw_humidity);
+    _capture_pt = false;
+  } else if (_capture) {
+    ms8607_capture_humidity(_capture, _clock->micros(), raw_humidity);
   }
-  _humidity = raw_hum * MS8607_RH_LSB;
-  _humidity -= 6;
+#endif
+  _humidity = ms8607_compute_humidity(raw_humidity);
+  _humidity_ms = _to_millis(_humidity_us);
+  _humidity_valid = true;
   return true;
 }
 
+/**
+ * @brief Get the most recently computed temperature
+ *
+ * @return int32_t the temperature in hundredths of a degree C
+ */
+int32_t Adafruit_MS8607::getTemperatureX100(void) { return _temperature; }
+
+/**
+ * @brief Get the most recently computed pressure
+ *
+ * @return int32_t the pressure in hundredths of a hPa
+ */
+int32_t Adafruit_MS8607::getPressureX100(void) { return _pressure; }
+
+/**
+ * @brief Get the most recently computed relative humidity
+ *
+ * @return int32_t the relative humidity in hundredths of a %rH
+ */
+int32_t Adafruit_MS8607::getHumidityX100(void) { return _humidity; }
+
+/**
+ * @brief Get when the most recent temperature was measured: the midpoint
+ * between the end of the command starting its conversion and the start of
+ * the read of its result, on the driver's clock. If the result was read
+ * later than the maximum conversion time, the window is taken to end then
+ *
+ * @return uint32_t the time in microseconds
+ */
+uint32_t Adafruit_MS8607::getTemperatureMicros(void) { return _temperature_us; }
+
+/**
+ * @brief Get when the most recent pressure was measured, like
+ * getTemperatureMicros()
+ *
+ * @return uint32_t the time in microseconds
+ */
+uint32_t Adafruit_MS8607::getPressureMicros(void) { return _pressure_us; }
+
+/**
+ * @brief Get when the most recent relative humidity was measured, like
+ * getTemperatureMicros(). With clock stretching the conversion window is
+ * the whole hold transaction, and with polling it ends at the read that
+ * succeeded
+ *
+ * @return uint32_t the time in microseconds
+ */
+uint32_t Adafruit_MS8607::getHumidityMicros(void) { return _humidity_us; }
+
+/**
+ * @brief Get how long ago the current temperature was measured. Values are
+ * only replaced by successful reads, so after a failure this keeps growing
+ *
+ * @return uint32_t the age in milliseconds, or MS8607_AGE_INVALID if no
+ * temperature has been read since begin()
+ */
+uint32_t Adafruit_MS8607::getTemperatureAge(void) {
+  return _pt_valid ? _clock->millis() - _temperature_ms : MS8607_AGE_INVALID;
+}
+
+/**
+ * @brief Get how long ago the current pressure was measured, like
+ * getTemperatureAge()
+ *
+ * @return uint32_t the age in milliseconds, or MS8607_AGE_INVALID
+ */
+uint32_t Adafruit_MS8607::getPressureAge(void) {
+  return _pt_valid ? _clock->millis() - _pressure_ms : MS8607_AGE_INVALID;
+}
+
+/**
+ * @brief Get how long ago the current relative humidity was measured, like
+ * getTemperatureAge()
+ *
+ * @return uint32_t the age in milliseconds, or MS8607_AGE_INVALID
+ */
+uint32_t Adafruit_MS8607::getHumidityAge(void) {
+  return _humidity_valid ? _clock->millis() - _humidity_ms
+                         : MS8607_AGE_INVALID;
+}
+
+#ifndef MS8607_NO_FLOAT
+/**
+ * @brief Get the most recently computed temperature
+ *
+ * @return float the temperature in degrees C
+ */
+float Adafruit_MS8607::getTemperature(void) { return _temperature / 100.0f; }
+
+/**
+ * @brief Get the most recently computed pressure
+ *
+ * @return float the pressure in hPa
+ */
+float Adafruit_MS8607::getPressure(void) { return _pressure / 100.0f; }
+
+/**
+ * @brief Get the most recently computed relative humidity
+ *
+ * @return float the relative humidity in %rH
+ */
+float Adafruit_MS8607::getHumidity(void) { return _humidity / 100.0f; }
+#endif
+
+#ifndef MS8607_NO_UNIFIED_SENSOR
 /********************* Sensor Methods ****************************************/
 /**
  * @brief Gets the Adafruit_Sensor object for the MS0607's temperature sensor
  * @return Adafruit_Sensor* a pointer to the temperature sensor object
  */
 Adafruit_Sensor *Adafruit_MS8607::getTemperatureSensor(void) {
-  return temp_sensor;
+  return &temp_sensor;
 }
 
 /**
@@ -507,7 +982,7 @@ Adafruit_Sensor *Adafruit_MS8607::getTemperatureSensor(void) {
  * @return Adafruit_Sensor* a pointer to the pressure sensor object
  */
 Adafruit_Sensor *Adafruit_MS8607::getPressureSensor(void) {
-  return pressure_sensor;
+  return &pressure_sensor;
 }
 
 /**
@@ -515,16 +990,16 @@ Adafruit_Sensor *Adafruit_MS8607::getPressureSensor(void) {
  * @return Adafruit_Sensor* a pointer to the humidity sensor object
  */
 Adafruit_Sensor *Adafruit_MS8607::getHumiditySensor(void) {
-  return humidity_sensor;
+  return &humidity_sensor;
 }
 void Adafruit_MS8607::fillHumidityEvent(sensors_event_t *humidity,
                                         uint32_t timestamp) {
   memset(humidity, 0, sizeof(sensors_event_t));
   humidity->version = sizeof(sensors_event_t);
   humidity->sensor_id = _sensorid_humidity;
-  humidity->type = SENSOR_TYPE_PRESSURE;
+  humidity->type = SENSOR_TYPE_RELATIVE_HUMIDITY;
   humidity->timestamp = timestamp;
-  humidity->relative_humidity = _humidity;
+  humidity->relative_humidity = _humidity / 100.0f;
 }
 void Adafruit_MS8607::fillTempEvent(sensors_event_t *temp, uint32_t timestamp) {
   memset(temp, 0, sizeof(sensors_event_t));
@@ -532,7 +1007,7 @@ void Adafruit_MS8607::fillTempEvent(sensors_event_t *temp, uint32_t timestamp) {
   temp->sensor_id = _sensorid_temp;
   temp->type = SENSOR_TYPE_AMBIENT_TEMPERATURE;
   temp->timestamp = timestamp;
-  temp->temperature = _temperature;
+  temp->temperature = _temperature / 100.0f;
 }
 
 void Adafruit_MS8607::fillPressureEvent(sensors_event_t *pressure,
@@ -542,70 +1017,236 @@ void Adafruit_MS8607::fillPressureEvent(sensors_event_t *pressure,
   pressure->sensor_id = _sensorid_pressure;
   pressure->type = SENSOR_TYPE_PRESSURE;
   pressure->timestamp = timestamp;
-  pressure->pressure = _pressure;
+  pressure->pressure = _pressure / 100.0f;
 }
+#endif
 /***************************  Private Methods *********************************/
-bool Adafruit_MS8607::_psensor_crc_check(uint16_t *n_prom, uint8_t crc) {
-  uint8_t cnt, n_bit;
-  uint16_t n_rem, crc_read;
+void Adafruit_MS8607::_release_transports(void) {
+  // destroyed through their storage, as pt_i2c_dev and hum_i2c_dev may point
+  // to monitors
+  if (_owns_transports) {
+    reinterpret_cast<Adafruit_MS8607_I2CTransport *>(_pt_transport_storage)
+        ->~Adafruit_MS8607_I2CTransport();
+    reinterpret_cast<Adafruit_MS8607_I2CTransport *>(_hum_transport_storage)
+        ->~Adafruit_MS8607_I2CTransport();
+  }
+  pt_i2c_dev = NULL;
+  hum_i2c_dev = NULL;
+  _owns_transports = false;
+}
 
-  n_rem = 0x00;
-  crc_read = n_prom[0];
-  n_prom[7] = 0;
-  n_prom[0] = (0x0FFF & (n_prom[0])); // Clear the CRC byte
+bool Adafruit_MS8607::_startPTConversion(uint8_t cmd) {
+  if (!_transfer(pt_i2c_dev, &cmd, 1, NULL, 0)) {
+    return false;
+  }
+  // the conversion starts when the command ends
+  _pt_start_us = _clock->micros();
+  _pt_temperature =
+      (cmd & 0xF0) == PSENSOR_START_TEMPERATURE_ADC_CONVERSION;
+  return true;
+}
 
-  for (cnt = 0; cnt < (7 + 1) * 2; cnt++) {
+uint32_t Adafruit_MS8607::_midpoint(uint32_t start_us, uint32_t end_us,
+                                    uint32_t conversion_us) {
+  // the difference is right across micros() rollover. A result read late
+  // was ready after at most the conversion time
+  uint32_t window_us = end_us - start_us;
+  if (window_us > conversion_us) {
+    window_us = conversion_us;
+  }
+  return start_us + window_us / 2;
+}
 
-    // Get next byte
-    if (cnt % 2 == 1)
-      n_rem ^= n_prom[cnt >> 1] & 0x00FF;
-    else
-      n_rem ^= n_prom[cnt >> 1] >> 8;
+void Adafruit_MS8607::_wait(uint32_t us) {
+  if (!_yield_callback) {
+    _clock->delayMicros(us);
+    return;
+  }
+  uint32_t start = _clock->micros();
+  uint32_t now = start;
+  while (now - start < us) {
+    _yield_callback(_yield_context);
+    uint32_t after = _clock->micros();
+    if (after == now) {
+      // the callback took no time, e.g. on a virtual clock that only moves
+      // when told to, so the clock is moved on to make progress
+      uint32_t left = us - (now - start);
+      _clock->delayMicros(left < MS8607_YIELD_STEP_US ? left
+                                                      : MS8607_YIELD_STEP_US);
+      after = _clock->micros();
+    }
+    now = after;
+  }
+}
+
+bool Adafruit_MS8607::_read_humidity_user_register(uint8_t *value) {
+  uint8_t buffer = HSENSOR_READ_USER_REG_COMMAND;
+  // with a stop after the command, as the register has always been read
+  if (!_transfer(hum_i2c_dev, &buffer, 1, &buffer, 1, true)) {
+    return false;
+  }
+  *value = buffer;
+  return true;
+}
+
+bool Adafruit_MS8607::_write_humidity_user_register(uint8_t new_reg_value) {
+  uint8_t buffer[2];
+  buffer[0] = HSENSOR_WRITE_USER_REG_COMMAND;
+  buffer[1] = new_reg_value;
+  return _transfer(hum_i2c_dev, buffer, 2, NULL, 0);
+}
 
-    for (n_bit = 8; n_bit > 0; n_bit--) {
+bool Adafruit_MS8607::_check(ms8607_status_t status) {
+  _status = status;
+  return status == MS8607_OK;
+}
 
-      if (n_rem & 0x8000)
-        n_rem = (n_rem << 1) ^ 0x3000;
-      else
-        n_rem <<= 1;
+bool Adafruit_MS8607::_transfer(Adafruit_MS8607_Transport *dev,
+                                const uint8_t *write_buffer, size_t write_len,
+                                uint8_t *read_buffer, size_t read_len,
+                                bool stop) {
+  uint8_t command[2];
+  uint32_t backoff_us = _recovery_policy.backoff_us;
+  ms8607_status_t status;
+
+  // the read may overwrite the command, so a copy is sent on each attempt
+  if (write_buffer && write_len <= sizeof(command)) {
+    memcpy(command, write_buffer, write_len);
+    write_buffer = command;
+  }
+  for (uint8_t attempt = 0;; attempt++) {
+    if (!read_buffer) {
+      status = dev->write(write_buffer, write_len);
+    } else if (!write_buffer) {
+      status = dev->read(read_buffer, read_len);
+    } else {
+      status = dev->write_then_read(write_buffer, write_len, read_buffer,
+                                    read_len, stop);
+    }
+    // bad arguments fail the same way every time
+    if (_check(status) || status == MS8607_ERR_INVALID ||
+        attempt >= _recovery_policy.retries) {
+      return status == MS8607_OK;
     }
+    _recovery_counters.retries++;
+    _wait(backoff_us);
+    backoff_us *= 2;
   }
-  n_rem >>= 12;
-  n_prom[0] = crc_read;
-  return (n_rem == crc);
 }
 
-bool Adafruit_MS8607::_hsensor_crc_check(uint16_t value, uint8_t crc) {
+bool Adafruit_MS8607::_read_all(bool read_humidity) {
+  bool ok = _read() && (!read_humidity || _read_humidity());
 
-  uint32_t polynom = 0x988000; // x^8 + x^5 + x^4 + 1
-  uint32_t msb = 0x800000;
-  uint32_t mask = 0xFF8000;
-  uint32_t result = (uint32_t)value << 8; // Pad with zeros as specified in spec
+#ifdef MS8607_ENABLE_CAPTURE
+  _capture_flush();
+#endif
+  return ok;
+}
 
-  while (msb != 0x80) {
+bool Adafruit_MS8607::_read_with_recovery(bool read_humidity) {
+  return _read_finished(_read_all(read_humidity) ||
+                        (_recover_if_due() && _read_all(read_humidity)));
+}
 
-    // Check if msb of current value is 1 and apply XOR mask
-    if (result & msb)
-      result = ((result ^ polynom) & mask) | (result & ~mask);
+bool Adafruit_MS8607::_read_finished(bool ok) {
+  // counts the outcome of a read once any recovery has been tried
+  if (ok) {
+    _failed_reads = 0;
+  } else {
+    _recovery_counters.failures++;
+  }
+  return ok;
+}
 
-    // Shift by one
-    msb >>= 1;
-    mask >>= 1;
-    polynom >>= 1;
+bool Adafruit_MS8607::_recover_if_due(void) {
+  // counts a failed read, and recovers once too many failed in a row
+  if (!_recovery_policy.reset_after ||
+      ++_failed_reads < _recovery_policy.reset_after) {
+    return false;
   }
-  return (result == crc);
+  _failed_reads = 0;
+  return _recover();
 }
 
-uint8_t Adafruit_MS8607::_read_humidity_user_register(void) {
-  uint8_t buffer = HSENSOR_READ_USER_REG_COMMAND;
-  hum_i2c_dev->write_then_read(&buffer, 1, &buffer, 1, true);
+bool Adafruit_MS8607::_update(bool read_humidity) {
+  if (_max_age_ms && _fresh(read_humidity)) {
+    return true;
+  }
+  return _read_with_recovery(read_humidity);
+}
 
-  return buffer;
+bool Adafruit_MS8607::_fresh(bool read_humidity) {
+  // invalid values have an age of MS8607_AGE_INVALID, so are never fresh
+  return getTemperatureAge() < _max_age_ms &&
+         (!read_humidity || getHumidityAge() < _max_age_ms);
 }
 
-bool Adafruit_MS8607::_write_humidity_user_register(uint8_t new_reg_value) {
+uint32_t Adafruit_MS8607::_to_millis(uint32_t time_us) {
+  // moves a time on the micros() timebase to the millis() one
+  return _clock->millis() - (_clock->micros() - time_us) / 1000;
+}
+
+bool Adafruit_MS8607::_recover(void) {
+  ms8607_humidity_resolution_t resolution = _hum_resolution;
+
+  _recovery_counters.resets++;
+  if (!reset()) {
+    return false;
+  }
+  if (resolution != MS8607_HUMIDITY_RESOLUTION_OSR_12b &&
+      !setHumidityResolution(resolution)) {
+    return false;
+  }
+  // a reset does not change the PROM, so it is only read again if the copy
+  // held here fails its check
+  if (_calibration_loaded && ms8607_check_calibration(&_calibration)) {
+    return true;
+  }
+  _recovery_counters.prom_reloads++;
+  return _read_calibration();
+}
+
+bool Adafruit_MS8607::_read_serial(void) {
+  uint8_t first[8], last[6];
+
+  first[0] = HSENSOR_READ_SERIAL_FIRST_8BYTES_COMMAND >> 8;
+  first[1] = HSENSOR_READ_SERIAL_FIRST_8BYTES_COMMAND & 0xFF;
+  if (!_transfer(hum_i2c_dev, first, 2, first, 8)) {
+    return false;
+  }
+  last[0] = HSENSOR_READ_SERIAL_LAST_6BYTES_COMMAND >> 8;
+  last[1] = HSENSOR_READ_SERIAL_LAST_6BYTES_COMMAND & 0xFF;
+  if (!_transfer(hum_i2c_dev, last, 2, last, 6)) {
+    return false;
+  }
+  return _check(ms8607_parse_serial(first, last, &_serial));
+}
+
+bool Adafruit_MS8607::_read_calibration(void) {
+  uint16_t prom[7];
   uint8_t buffer[2];
-  buffer[0] = HSENSOR_WRITE_USER_REG_COMMAND;
-  buffer[1] = new_reg_value;
-  return hum_i2c_dev->write(buffer, 2);
+
+  // word by word through _transfer(), so the recovery policy's retries and
+  // backoff apply
+  _calibration_loaded = false;
+  for (uint8_t i = 0; i < 7; i++) {
+    buffer[0] = PROM_ADDRESS_READ_ADDRESS_0 + 2 * i;
+    if (!_transfer(pt_i2c_dev, buffer, 1, buffer, 2)) {
+      return false;
+    }
+    prom[i] = (uint16_t)buffer[0] << 8 | buffer[1];
+  }
+  if (!_check(ms8607_parse_calibration(prom, &_calibration))) {
+    return false;
+  }
+  _calibration_loaded = true;
+  return true;
+}
+
+bool Adafruit_MS8607::_parse_humidity(const uint8_t *buffer, uint16_t *raw) {
+  if (!ms8607_parse_humidity(buffer, raw)) {
+    _status = MS8607_ERR_CRC;
+    return false;
+  }
+  return true;
 }
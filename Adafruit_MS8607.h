@@ -79,11 +79,29 @@
 #ifndef __MS8607_H__
 #define __MS8607_H__
 
+// Build options, for parts where flash is tight:
+//   MS8607_NO_UNIFIED_SENSOR leaves out the Adafruit_Sensor interface
+//   MS8607_NO_FLOAT leaves out the float results, keeping only the integer
+//   ones. Unified Sensor events hold floats, so it implies
+//   MS8607_NO_UNIFIED_SENSOR
+#if defined(MS8607_NO_FLOAT) && !defined(MS8607_NO_UNIFIED_SENSOR)
+#define MS8607_NO_UNIFIED_SENSOR
+#endif
+
 #include "Arduino.h"
 #include <Adafruit_BusIO_Register.h>
+#include <Adafruit_MS8607_Async.h>
+#include <Adafruit_MS8607_Capture.h>
+#include <Adafruit_MS8607_Clock.h>
+#include <Adafruit_MS8607_Compensation.h>
+#include <Adafruit_MS8607_Monitor.h>
+#include <Adafruit_MS8607_Transport.h>
 #include <Adafruit_I2CDevice.h>
+#ifndef MS8607_NO_UNIFIED_SENSOR
 #include <Adafruit_Sensor.h>
+#endif
 #include <Wire.h>
+#include <new>
 
 /*!
  *  I2C ADDRESS/BITS/SETTINGS. The MS8607 uses two different I2C addresses
@@ -177,6 +195,14 @@
   0x50                        ///< Command to start temperature ADC measurement
 #define PSENSOR_READ_ADC 0x00 ///< Temp and pressure ADC read command
 
+// Pressure and temperature maximum conversion timings, in microseconds
+#define PSENSOR_CONVERSION_TIME_OSR_256 560    ///< conversion time OSR 256
+#define PSENSOR_CONVERSION_TIME_OSR_512 1100   ///< conversion time OSR 512
+#define PSENSOR_CONVERSION_TIME_OSR_1024 2170  ///< conversion time OSR 1024
+#define PSENSOR_CONVERSION_TIME_OSR_2048 4320  ///< conversion time OSR 2048
+#define PSENSOR_CONVERSION_TIME_OSR_4096 8610  ///< conversion time OSR 4096
+#define PSENSOR_CONVERSION_TIME_OSR_8192 17200 ///< conversion time OSR 8192
+
 /**
  * @brief Pressure sensor resolution options
  *
@@ -210,12 +236,49 @@ typedef enum {
   MS8607_I2C_NO_HOLD = 0xF5,
 } ms8607_hum_clock_stretch_t;
 
+#define MS8607_RECOVERY_RETRIES 2 ///< Default extra attempts per transaction
+#define MS8607_RECOVERY_BACKOFF_US                                             \
+  100 ///< Default wait before the first retry, in microseconds
+#define MS8607_RECOVERY_RESET_AFTER                                            \
+  3 ///< Default failed reads in a row before a reset
+
+/**
+ * @brief How the driver recovers from failed transactions and reads
+ *
+ */
+typedef struct {
+  uint8_t retries;     ///< Extra attempts at a failed transaction
+  uint16_t backoff_us; ///< Wait before the first retry, doubling after
+  uint8_t reset_after; ///< Failed reads in a row before a reset, 0 for never
+} ms8607_recovery_policy_t;
+
+/**
+ * @brief How often each level of recovery was needed
+ *
+ */
+typedef struct {
+  uint32_t retries;      ///< Transactions tried again
+  uint32_t resets;       ///< Soft resets after repeated failed reads
+  uint32_t prom_reloads; ///< Calibration read again after failing its check
+  uint32_t failures;     ///< Reads that failed in spite of recovery
+} ms8607_recovery_counters_t;
+
+#define MS8607_DEFAULT_SENSOR_ID                                               \
+  0x8600 ///< Temperature sensor ID without a serial number or sensor_id
+#define MS8607_AGE_INVALID 0xFFFFFFFF ///< Age of a value never read
+
 class Adafruit_MS8607;
 
+/** Callback run repeatedly while the driver waits for a conversion */
+typedef void (*ms8607_yield_callback_t)(void *context);
+#define MS8607_YIELD_STEP_US                                                   \
+  100 ///< Longest delay between yield callbacks that take no time
+
 #define HSENSOR_READ_HUMIDITY_W_HOLD_COMMAND                                   \
   0xE5 ///< read humidity w hold command
 #define HSENSOR_READ_HUMIDITY_WO_HOLD_COMMAND                                  \
   0xF5 ///< read humidity wo hold command
+#ifndef MS8607_NO_UNIFIED_SENSOR
 /**
  * @brief Adafruit Unified Sensor interface for the temperature sensor component
  * of the MS8607
@@ -232,7 +295,6 @@ public:
   void getSensor(sensor_t *);
 
 private:
-  int _sensorID = 0x8600;
   Adafruit_MS8607 *_theMS8607 = NULL;
 };
 /**
@@ -250,7 +312,6 @@ public:
   void getSensor(sensor_t *);
 
 private:
-  int _sensorID = 0x8601;
   Adafruit_MS8607 *_theMS8607 = NULL;
 };
 
@@ -269,9 +330,9 @@ public:
   void getSensor(sensor_t *);
 
 private:
-  int _sensorID = 0x8602;
   Adafruit_MS8607 *_theMS8607 = NULL;
 };
+#endif
 
 /**
  * Driver for the Adafruit MS8607 PHT sensor.
@@ -282,10 +343,16 @@ public:
   ~Adafruit_MS8607(void);
 
   bool begin(TwoWire *wire = &Wire, int32_t sensor_id = 0);
+  bool begin(Adafruit_MS8607_Transport *pt_transport,
+             Adafruit_MS8607_Transport *hum_transport, int32_t sensor_id = 0);
   bool init(int32_t sensor_id);
 
   bool reset(void);
 
+  bool getSerialNumber(uint64_t *serial);
+  bool getCalibration(ms8607_calibration_t *calibration);
+  bool setCalibration(const ms8607_calibration_t *calibration);
+
   ms8607_humidity_resolution_t getHumidityResolution(void);
   bool setHumidityResolution(ms8607_humidity_resolution_t res);
 
@@ -293,40 +360,142 @@ public:
   bool setPressureResolution(ms8607_pressure_resolution_t res);
 
   bool enableHumidityClockStretching(bool enable_stretching);
-
+  void setHumidityPolling(uint32_t interval_us, uint32_t timeout_us = 20000);
+
+  void setClock(Adafruit_MS8607_Clock *clock);
+  Adafruit_MS8607_Clock *getClock(void);
+  void setYieldCallback(ms8607_yield_callback_t callback,
+                        void *context = NULL);
+
+  bool read(bool read_humidity = true);
+  ms8607_status_t getStatus(void);
+  void setRecoveryPolicy(const ms8607_recovery_policy_t *policy);
+  void getRecoveryCounters(ms8607_recovery_counters_t *counters);
+  void resetRecoveryCounters(void);
+  void setMaxSampleAge(uint32_t max_age_ms);
+#ifndef MS8607_NO_UNIFIED_SENSOR
   bool getEvent(sensors_event_t *pressure, sensors_event_t *temp,
                 sensors_event_t *humidity);
   Adafruit_Sensor *getTemperatureSensor(void);
   Adafruit_Sensor *getPressureSensor(void);
   Adafruit_Sensor *getHumiditySensor(void);
+#endif
+
+  bool startTemperatureConversion(void);
+  bool startPressureConversion(void);
+  bool readPTConversion(uint32_t *raw);
+  bool startHumidityConversion(void);
+  bool readHumidityConversion(uint16_t *raw);
+  uint32_t getPTConversionTime(void);
+  uint32_t getHumidityConversionTime(void);
+
+  bool computePressureTemperature(uint32_t raw_temp, uint32_t raw_pressure);
+  bool computeHumidity(uint16_t raw_humidity);
+  int32_t getTemperatureX100(void);
+  int32_t getPressureX100(void);
+  int32_t getHumidityX100(void);
+  uint32_t getTemperatureMicros(void);
+  uint32_t getPressureMicros(void);
+  uint32_t getHumidityMicros(void);
+  uint32_t getTemperatureAge(void);
+  uint32_t getPressureAge(void);
+  uint32_t getHumidityAge(void);
+#ifndef MS8607_NO_FLOAT
+  float getTemperature(void);
+  float getPressure(void);
+  float getHumidity(void);
+#endif
+
+#ifdef MS8607_HAS_COROUTINES
+  Adafruit_MS8607_Task readAsync(Adafruit_MS8607_EventLoop &loop,
+                                 bool read_humidity = true);
+#endif
+
+#ifdef MS8607_ENABLE_STATS
+  void getStats(ms8607_stats_t *stats);
+  void resetStats(void);
+#endif
+#ifdef MS8607_ENABLE_TRACE
+  uint16_t getTrace(ms8607_trace_entry_t *entries, uint16_t max_entries);
+  void dumpTrace(Print *out);
+  void clearTrace(void);
+#endif
+#ifdef MS8607_ENABLE_CAPTURE
+  bool startCapture(Print *out);
+  void stopCapture(void);
+#endif
 
 protected:
   // uint16_t _sensorid_presure;     ///< ID number for pressure
-  uint16_t _sensorid_temp;     ///< ID number for temperature
-  uint16_t _sensorid_pressure; ///< ID number for pressure
-  uint16_t _sensorid_humidity; ///< ID number for humidity
-
-  Adafruit_I2CDevice *pt_i2c_dev = NULL; ///< Pointer to I2C bus interface for
-                                         ///< the pressure & temperature sensor
-  Adafruit_I2CDevice *hum_i2c_dev =
-      NULL; ///< Pointer to I2C bus interface for the humidity sensor
+  int32_t _sensorid_temp = MS8607_DEFAULT_SENSOR_ID; ///< ID for temperature
+  int32_t _sensorid_pressure =
+      MS8607_DEFAULT_SENSOR_ID + 1; ///< ID number for pressure
+  int32_t _sensorid_humidity =
+      MS8607_DEFAULT_SENSOR_ID + 2; ///< ID number for humidity
+
+  Adafruit_MS8607_Transport *pt_i2c_dev =
+      NULL; ///< Pointer to bus interface for the pressure & temperature sensor
+  Adafruit_MS8607_Transport *hum_i2c_dev =
+      NULL; ///< Pointer to bus interface for the humidity sensor
+  bool _owns_transports = false; ///< Whether the bus interfaces were built
+                                 ///< in place by begin() and must be destroyed
+  alignas(Adafruit_MS8607_I2CTransport) uint8_t _pt_transport_storage[sizeof(
+      Adafruit_MS8607_I2CTransport)]; ///< Space for the built-in pressure &
+                                      ///< temperature bus interface
+  alignas(Adafruit_MS8607_I2CTransport) uint8_t _hum_transport_storage[sizeof(
+      Adafruit_MS8607_I2CTransport)]; ///< Space for the built-in humidity bus
+                                      ///< interface
+
+#ifndef MS8607_NO_UNIFIED_SENSOR
+  Adafruit_MS8607_Temp temp_sensor;         ///< Temp sensor data object
+  Adafruit_MS8607_Pressure pressure_sensor; ///< Pressure sensor data object
+  Adafruit_MS8607_Humidity humidity_sensor; ///< Humidity sensor data object
+#endif
 
-  Adafruit_MS8607_Temp *temp_sensor = NULL; ///< Temp sensor data object
-  Adafruit_MS8607_Pressure *pressure_sensor =
-      NULL; ///< Pressure sensor data object
-  Adafruit_MS8607_Humidity *humidity_sensor =
-      NULL; ///< Humidity sensor data object
+  Adafruit_MS8607_Clock *_clock; ///< Time source for timestamps and waits
+  ms8607_yield_callback_t _yield_callback = NULL; ///< Called during waits
+  void *_yield_context = NULL; ///< Passed to _yield_callback
 
 private:
+  bool _begin(int32_t sensor_id);
+  void _release_transports(void);
   bool _read(void);
   bool _read_humidity(void);
-  bool _psensor_crc_check(uint16_t *n_prom, uint8_t crc);
-  bool _hsensor_crc_check(uint16_t value, uint8_t crc);
+  bool _check(ms8607_status_t status);
+  bool _transfer(Adafruit_MS8607_Transport *dev, const uint8_t *write_buffer,
+                 size_t write_len, uint8_t *read_buffer, size_t read_len,
+                 bool stop = false);
+  bool _read_all(bool read_humidity);
+#ifdef MS8607_HAS_COROUTINES
+  Adafruit_MS8607_Task _read_all_async(Adafruit_MS8607_EventLoop &loop,
+                                       bool read_humidity);
+#endif
+  bool _read_with_recovery(bool read_humidity);
+  bool _read_finished(bool ok);
+  bool _recover_if_due(void);
+  bool _recover(void);
+  bool _read_serial(void);
+  bool _read_calibration(void);
+  bool _update(bool read_humidity);
+  bool _fresh(bool read_humidity);
+  uint32_t _to_millis(uint32_t time_us);
+  bool _parse_humidity(const uint8_t *buffer, uint16_t *raw);
+  bool _startPTConversion(uint8_t cmd);
+  uint32_t _midpoint(uint32_t start_us, uint32_t end_us,
+                     uint32_t conversion_us);
+  void _wait(uint32_t us);
+#ifdef MS8607_ENABLE_CAPTURE
+  void _capture_flush(void);
+#endif
 
-  bool _fetch_temp_calibration_values(void);
-  uint8_t _read_humidity_user_register(void);
+  bool _read_humidity_user_register(uint8_t *value);
   bool _write_humidity_user_register(uint8_t new_reg_value);
 
+  friend class Adafruit_MS8607_Scheduler; ///< Gives access to the event fill
+                                          ///< and capture helpers to the
+                                          ///< scheduler
+
+#ifndef MS8607_NO_UNIFIED_SENSOR
   friend class Adafruit_MS8607_Temp;     ///< Gives access to private members to
                                          ///< Temperature data object
   friend class Adafruit_MS8607_Pressure; ///< Gives access to private members to
@@ -337,20 +506,94 @@ private:
   void fillTempEvent(sensors_event_t *temp, uint32_t timestamp);
   void fillPressureEvent(sensors_event_t *temp, uint32_t timestamp);
   void fillHumidityEvent(sensors_event_t *humidity, uint32_t timestamp);
+#endif
 
   void _applyTemperatureCorrection(void);
-  bool _applyPTCorrections(int32_t raw_temp, int32_t raw_pressure);
 
-  float _pressure,  ///< The current pressure measurement
-      _temperature, ///< the current temperature measurement
-      _humidity;    ///< The current humidity measurement
+  int32_t _pressure,  ///< The current pressure measurement, hPa x 100
+      _temperature,   ///< the current temperature measurement, C x 100
+      _humidity;      ///< The current humidity measurement, %rH x 100
   ms8607_pressure_resolution_t psensor_resolution_osr;
-  uint16_t press_sens, press_offset, press_sens_temp_coeff,
-      press_offset_temp_coeff, ref_temp,
-      temp_temp_coeff; ///< calibration constants
+  ms8607_humidity_resolution_t _hum_resolution =
+      MS8607_HUMIDITY_RESOLUTION_OSR_12b; ///< Cached by
+                                          ///< setHumidityResolution()
+  ms8607_calibration_t _calibration; ///< calibration constants
+  bool _calibration_loaded = false;  ///< Whether _calibration is valid
+  bool _calibration_cached = false;  ///< Whether begin() skips the PROM
+  uint64_t _serial = 0;              ///< Humidity sensor serial number
+  bool _serial_valid = false;        ///< Whether _serial was read
   ms8607_hum_clock_stretch_t
       _hum_sensor_i2c_read_mode; ///< The current I2C mode to use for humidity
                                  ///< reads
+  ms8607_status_t _status = MS8607_OK;   ///< Result of the last transaction
+  ms8607_recovery_policy_t _recovery_policy; ///< How failures are handled
+  ms8607_recovery_counters_t _recovery_counters; ///< Recoveries made
+  uint8_t _failed_reads = 0; ///< Reads failed in a row since the last reset
+  uint32_t _hum_poll_interval_us = 0;    ///< No-hold poll interval, or 0
+  uint32_t _hum_poll_timeout_us = 20000; ///< Longest time to poll for
+
+  uint32_t _pt_start_us = 0;    ///< When the last PT conversion started
+  bool _pt_temperature = false; ///< Whether it converts temperature
+  uint32_t _hum_start_us = 0;   ///< When the last humidity conversion started
+  uint32_t _temperature_us = 0; ///< Midpoint of the temperature conversion
+  uint32_t _pressure_us = 0;    ///< Midpoint of the pressure conversion
+  uint32_t _humidity_us = 0;    ///< Midpoint of the humidity conversion
+
+  uint32_t _temperature_ms = 0; ///< _temperature_us on the millis() timebase
+  uint32_t _pressure_ms = 0;    ///< _pressure_us on the millis() timebase
+  uint32_t _humidity_ms = 0;    ///< _humidity_us on the millis() timebase
+  bool _pt_valid = false;       ///< Whether a temperature & pressure was read
+  bool _humidity_valid = false; ///< Whether a humidity was read
+  uint32_t _max_age_ms = 0;     ///< Oldest values read() may serve, or 0
+
+#ifdef MS8607_MONITOR
+  /** Transport that records each transaction and passes it on */
+  class Monitor final : public Adafruit_MS8607_Transport {
+  public:
+    /** @brief Create a monitor
+        @param driver The driver to report transactions to
+        @param is_pt true for the pressure & temperature sensor */
+    Monitor(Adafruit_MS8607 *driver, bool is_pt)
+        : _driver(driver), _is_pt(is_pt) {}
+    /** @brief Set the transport to pass transactions on to
+        @param transport The transport */
+    void setTransport(Adafruit_MS8607_Transport *transport) {
+      _transport = transport;
+    }
+    ms8607_status_t begin(void);
+    ms8607_status_t write(const uint8_t *buffer, size_t len);
+    ms8607_status_t read(uint8_t *buffer, size_t len);
+    ms8607_status_t write_then_read(const uint8_t *write_buffer,
+                                    size_t write_len, uint8_t *read_buffer,
+                                    size_t read_len, bool stop = false);
+
+  private:
+    Adafruit_MS8607 *_driver;                     ///< The driver
+    Adafruit_MS8607_Transport *_transport = NULL; ///< Transport passed on to
+    bool _is_pt; ///< true for the pressure & temperature sensor
+  };
+
+  void _record(bool is_pt, const uint8_t *write_buffer, size_t write_len,
+               size_t read_len, uint32_t start_us, ms8607_status_t status);
+
+  Monitor _pt_monitor{this, true};   ///< Monitors pressure & temperature
+  Monitor _hum_monitor{this, false}; ///< Monitors humidity
+#endif
+#ifdef MS8607_ENABLE_STATS
+  ms8607_stats_t _stats; ///< Transaction statistics
+#endif
+#ifdef MS8607_ENABLE_TRACE
+  ms8607_trace_entry_t _trace[MS8607_TRACE_LEN]; ///< Most recent transactions
+  uint16_t _trace_next = 0;  ///< Where the next transaction is recorded
+  uint16_t _trace_count = 0; ///< Entries in use
+#endif
+#ifdef MS8607_ENABLE_CAPTURE
+  Print *_capture = NULL; ///< Where raw values are captured, or NULL
+  bool _capture_pt = false; ///< Temperature & pressure are held back
+  uint32_t _capture_time_us = 0;      ///< When the held back values were read
+  uint32_t _capture_raw_temp = 0;     ///< Held back raw temperature (D2)
+  uint32_t _capture_raw_pressure = 0; ///< Held back raw pressure (D1)
+#endif
 };
 #endif
 /*
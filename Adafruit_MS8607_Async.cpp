@@ -0,0 +1,165 @@
+/*!
+ *  @file Adafruit_MS8607_Async.cpp
+ *
+ *  C++20 coroutine support for the MS8607
+ *
+ *  MIT license, all text above must be included in any redistribution
+ */
+
+#include <Adafruit_MS8607.h>
+
+#ifdef MS8607_HAS_COROUTINES
+
+/**
+ * @brief Read pressure, temperature and optionally humidity like read(),
+ * suspending during each conversion rather than waiting. Failures are
+ * retried and recovered from as setRecoveryPolicy() sets, and values younger
+ * than setMaxSampleAge() are kept without reading. Humidity is always read
+ * without clock stretching, so that it suspends too. The backoff between
+ * retries and the resets of a recovery still wait on the clock. On success
+ * the results are available from getPressure(), getTemperature() and
+ * getHumidity()
+ *
+ * @param loop The event loop that resumes the read after each conversion
+ * @param read_humidity true: read humidity as well
+ * @return Adafruit_MS8607_Task a task completing with true on success
+ */
+Adafruit_MS8607_Task
+Adafruit_MS8607::readAsync(Adafruit_MS8607_EventLoop &loop,
+                           bool read_humidity) {
+  if (_max_age_ms && _fresh(read_humidity)) {
+    co_return true;
+  }
+  // awaited from locals: GCC 12 loses a temporary task awaited inside a
+  // condition
+  Adafruit_MS8607_Task read = _read_all_async(loop, read_humidity);
+  bool ok = co_await read;
+#ifdef MS8607_ENABLE_CAPTURE
+  _capture_flush();
+#endif
+  if (!ok && _recover_if_due()) {
+    Adafruit_MS8607_Task retry = _read_all_async(loop, read_humidity);
+    ok = co_await retry;
+#ifdef MS8607_ENABLE_CAPTURE
+    _capture_flush();
+#endif
+  }
+  co_return _read_finished(ok);
+}
+
+Adafruit_MS8607_Task
+Adafruit_MS8607::_read_all_async(Adafruit_MS8607_EventLoop &loop,
+                                 bool read_humidity) {
+  uint32_t raw_temp, raw_pressure;
+  uint16_t raw_hum;
+
+  if (!startTemperatureConversion()) {
+    co_return false;
+  }
+  co_await loop.sleepFor(getPTConversionTime());
+  if (!readPTConversion(&raw_temp)) {
+    co_return false;
+  }
+
+  if (!startPressureConversion()) {
+    co_return false;
+  }
+  co_await loop.sleepFor(getPTConversionTime());
+  if (!readPTConversion(&raw_pressure)) {
+    co_return false;
+  }
+
+  if (!computePressureTemperature(raw_temp, raw_pressure)) {
+    co_return false;
+  }
+  if (!read_humidity) {
+    co_return true;
+  }
+  if (!startHumidityConversion()) {
+    co_return false;
+  }
+  co_await loop.sleepFor(getHumidityConversionTime());
+  if (!readHumidityConversion(&raw_hum)) {
+    co_return false;
+  }
+  co_return computeHumidity(raw_hum);
+}
+
+/*!
+ *    @brief  Instantiates a new event loop
+ *    @param  clock The time source for deadlines, and for waiting when no
+ *            coroutine is ready to run
+ */
+Adafruit_MS8607_EventLoop::Adafruit_MS8607_EventLoop(
+    Adafruit_MS8607_Clock *clock) {
+  _clock = clock;
+}
+
+/**
+ * @brief Suspend the awaiting coroutine for a time
+ *
+ * @param us The time to suspend for in microseconds
+ * @return SleepAwaiter the object to co_await
+ */
+Adafruit_MS8607_EventLoop::SleepAwaiter
+Adafruit_MS8607_EventLoop::sleepFor(uint32_t us) {
+  return SleepAwaiter{this, _clock->micros() + us};
+}
+
+/**
+ * @brief Start a task on this loop. The task runs until its first wait
+ * before this returns, and must outlive the loop's run()
+ *
+ * @param task The task to start
+ */
+void Adafruit_MS8607_EventLoop::spawn(Adafruit_MS8607_Task &task) {
+  if (task._handle && !task._handle.done()) {
+    task._handle.resume();
+  }
+}
+
+/**
+ * @brief Resume every coroutine whose deadline has passed, without waiting
+ *
+ * @return true: coroutines are still suspended false: nothing left to run
+ */
+bool Adafruit_MS8607_EventLoop::runOnce(void) {
+  uint32_t now_us = _clock->micros();
+
+  while (!_timers.empty() &&
+         (int32_t)(now_us - _timers.top().deadline_us) >= 0) {
+    std::coroutine_handle<> h = _timers.top().h;
+    _timers.pop();
+    h.resume();
+  }
+  return !_timers.empty();
+}
+
+/**
+ * @brief Run until every suspended coroutine has finished, waiting on the
+ * clock between deadlines
+ *
+ */
+void Adafruit_MS8607_EventLoop::run(void) {
+  while (runOnce()) {
+    int32_t remaining_us =
+        (int32_t)(_timers.top().deadline_us - _clock->micros());
+    if (remaining_us > 0) {
+      _clock->delayMicros(remaining_us);
+    }
+  }
+}
+
+/**
+ * @brief Get the number of suspended coroutines
+ *
+ * @return size_t the number waiting for a deadline
+ */
+size_t Adafruit_MS8607_EventLoop::pending(void) { return _timers.size(); }
+
+void Adafruit_MS8607_EventLoop::_schedule(uint32_t deadline_us,
+                                          std::coroutine_handle<> h) {
+  _timers.push(Timer{deadline_us, _sequence++, h});
+}
+
+#endif // MS8607_HAS_COROUTINES
@@ -0,0 +1,190 @@
+/*!
+ *  @file Adafruit_MS8607_Async.h
+ *
+ *  C++20 coroutine support for the MS8607. Adafruit_MS8607::readAsync()
+ *  suspends during conversions instead of waiting, so many sensors can be
+ *  read concurrently from a single thread running an
+ *  Adafruit_MS8607_EventLoop.
+ *
+ *  Only available with compilers and standard libraries supporting
+ *  coroutines; MS8607_HAS_COROUTINES is defined when it is.
+ *
+ *  MIT license, all text above must be included in any redistribution
+ */
+
+#ifndef __MS8607_ASYNC_H__
+#define __MS8607_ASYNC_H__
+
+#if defined(__cpp_impl_coroutine) && defined(__has_include)
+#if __has_include(<coroutine>)
+#define MS8607_HAS_COROUTINES ///< Coroutine API is available
+#endif
+#endif
+
+#ifdef MS8607_HAS_COROUTINES
+
+#include <Adafruit_MS8607_Clock.h>
+#include <coroutine>
+#include <exception>
+#include <queue>
+#include <vector>
+
+/**
+ * @brief Coroutine returned by Adafruit_MS8607::readAsync(). The read starts
+ * when the task is awaited or passed to Adafruit_MS8607_EventLoop::spawn(),
+ * and completes with true on success
+ */
+class Adafruit_MS8607_Task {
+public:
+  /** @brief Coroutine state shared between the task and its body */
+  struct promise_type {
+    bool result = false; ///< Value given to co_return
+    std::coroutine_handle<> continuation; ///< Coroutine awaiting this task
+
+    /** @brief Create the task object returned to the caller
+        @return Adafruit_MS8607_Task the task */
+    Adafruit_MS8607_Task get_return_object() {
+      return Adafruit_MS8607_Task(
+          std::coroutine_handle<promise_type>::from_promise(*this));
+    }
+    /** @brief Tasks are lazy and do not start until awaited or spawned
+        @return std::suspend_always */
+    std::suspend_always initial_suspend() noexcept { return {}; }
+
+    /** @brief Resumes the awaiting coroutine, if any, on completion */
+    struct FinalAwaiter {
+      /** @brief Always suspend
+          @return false */
+      bool await_ready() noexcept { return false; }
+      /** @brief Transfer control to the awaiting coroutine
+          @param h The completed task
+          @return std::coroutine_handle<> the coroutine to resume */
+      std::coroutine_handle<>
+      await_suspend(std::coroutine_handle<promise_type> h) noexcept {
+        if (h.promise().continuation) {
+          return h.promise().continuation;
+        }
+        return std::noop_coroutine();
+      }
+      /** @brief Nothing to return */
+      void await_resume() noexcept {}
+    };
+    /** @brief Suspend on completion so the result stays readable
+        @return FinalAwaiter */
+    FinalAwaiter final_suspend() noexcept { return {}; }
+    /** @brief Store the result of the read
+        @param value true: success false: failure */
+    void return_value(bool value) { result = value; }
+    /** @brief Exceptions are not used by the driver */
+    void unhandled_exception() { std::terminate(); }
+  };
+
+  /** @brief Take ownership of a coroutine
+      @param handle The coroutine */
+  explicit Adafruit_MS8607_Task(std::coroutine_handle<promise_type> handle)
+      : _handle(handle) {}
+  /** @brief Move a task
+      @param other The task to move from */
+  Adafruit_MS8607_Task(Adafruit_MS8607_Task &&other) noexcept
+      : _handle(other._handle) {
+    other._handle = nullptr;
+  }
+  Adafruit_MS8607_Task(const Adafruit_MS8607_Task &) = delete;
+  Adafruit_MS8607_Task &operator=(const Adafruit_MS8607_Task &) = delete;
+  ~Adafruit_MS8607_Task() {
+    if (_handle) {
+      _handle.destroy();
+    }
+  }
+
+  /** @brief Check whether the read has finished
+      @return true: finished false: still running or not started */
+  bool done(void) { return _handle && _handle.done(); }
+  /** @brief Get the result of a finished read
+      @return true: success false: failure */
+  bool result(void) { return _handle.promise().result; }
+
+  /** @brief Check whether awaiting can complete immediately
+      @return true if the task has already finished */
+  bool await_ready() { return done(); }
+  /** @brief Start the task, resuming the awaiting coroutine when it finishes
+      @param awaiting The coroutine awaiting this task
+      @return std::coroutine_handle<> the task to run */
+  std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) {
+    _handle.promise().continuation = awaiting;
+    return _handle;
+  }
+  /** @brief Get the task result when resumed
+      @return true: success false: failure */
+  bool await_resume() { return result(); }
+
+private:
+  friend class Adafruit_MS8607_EventLoop;
+  std::coroutine_handle<promise_type> _handle; ///< The owned coroutine
+};
+
+/**
+ * @brief Single-threaded scheduler for coroutines suspended on timed waits
+ *
+ */
+class Adafruit_MS8607_EventLoop {
+public:
+  /** @brief Awaitable that resumes once a deadline has passed */
+  struct SleepAwaiter {
+    Adafruit_MS8607_EventLoop *loop; ///< The loop that will resume us
+    uint32_t deadline_us;            ///< When to resume
+
+    /** @brief Check whether the deadline has already passed
+        @return true: no need to suspend */
+    bool await_ready() {
+      return (int32_t)(loop->_clock->micros() - deadline_us) >= 0;
+    }
+    /** @brief Queue the coroutine until the deadline
+        @param h The suspended coroutine */
+    void await_suspend(std::coroutine_handle<> h) {
+      loop->_schedule(deadline_us, h);
+    }
+    /** @brief Nothing to return */
+    void await_resume() {}
+  };
+
+  Adafruit_MS8607_EventLoop(Adafruit_MS8607_Clock *clock);
+
+  SleepAwaiter sleepFor(uint32_t us);
+  void spawn(Adafruit_MS8607_Task &task);
+  bool runOnce(void);
+  void run(void);
+  size_t pending(void);
+
+private:
+  /** A suspended coroutine and when to resume it */
+  struct Timer {
+    uint32_t deadline_us;     ///< When to resume
+    uint32_t sequence;        ///< Keeps equal deadlines in FIFO order
+    std::coroutine_handle<> h; ///< The coroutine to resume
+  };
+  /** Orders the timer queue with the earliest deadline on top */
+  struct Later {
+    /** @brief Compare two timers
+        @param a First timer
+        @param b Second timer
+        @return true if a should run after b */
+    bool operator()(const Timer &a, const Timer &b) const {
+      int32_t diff = (int32_t)(a.deadline_us - b.deadline_us);
+      if (diff != 0) {
+        return diff > 0;
+      }
+      return (int32_t)(a.sequence - b.sequence) > 0;
+    }
+  };
+
+  void _schedule(uint32_t deadline_us, std::coroutine_handle<> h);
+
+  Adafruit_MS8607_Clock *_clock; ///< Time source for deadlines and waits
+  uint32_t _sequence = 0;        ///< Next timer sequence number
+  std::priority_queue<Timer, std::vector<Timer>, Later>
+      _timers; ///< Suspended coroutines by deadline
+};
+
+#endif // MS8607_HAS_COROUTINES
+#endif
@@ -0,0 +1,184 @@
+/*!
+ *  @file Adafruit_MS8607_Capture.cpp
+ *
+ *  Capture of raw MS8607 readings for replay
+ *
+ *  MIT license, all text above must be included in any redistribution
+ */
+
+#include <Adafruit_MS8607.h>
+
+static void put16(uint8_t *buffer, uint16_t value) {
+  buffer[0] = value;
+  buffer[1] = value >> 8;
+}
+
+static void put24(uint8_t *buffer, uint32_t value) {
+  put16(buffer, value);
+  buffer[2] = value >> 16;
+}
+
+static void put32(uint8_t *buffer, uint32_t value) {
+  put24(buffer, value);
+  buffer[3] = value >> 24;
+}
+
+static uint16_t get16(const uint8_t *buffer) {
+  return buffer[0] | (uint16_t)buffer[1] << 8;
+}
+
+/**
+ * @brief Start a capture with its header
+ *
+ * @param out Where to write the capture
+ * @param calibration The calibration constants of the sensor captured
+ * @return true: success false: the header could not be written
+ */
+bool ms8607_capture_header(Print *out,
+                           const ms8607_calibration_t *calibration) {
+  uint8_t buffer[MS8607_CAPTURE_HEADER_LEN] = {'M', 'S', '8', '6',
+                                               MS8607_CAPTURE_VERSION};
+
+  put16(&buffer[5], calibration->prom_crc);
+  put16(&buffer[7], calibration->press_sens);
+  put16(&buffer[9], calibration->press_offset);
+  put16(&buffer[11], calibration->press_sens_temp_coeff);
+  put16(&buffer[13], calibration->press_offset_temp_coeff);
+  put16(&buffer[15], calibration->ref_temp);
+  put16(&buffer[17], calibration->temp_temp_coeff);
+  return out->write(buffer, sizeof(buffer)) == sizeof(buffer);
+}
+
+/**
+ * @brief Add a temperature & pressure record to a capture
+ *
+ * @param out Where the capture is written
+ * @param time_us When the values were read, in microseconds
+ * @param raw_temp The raw temperature (D2) value
+ * @param raw_pressure The raw pressure (D1) value
+ * @return true: success false: the record could not be written
+ */
+bool ms8607_capture_pt(Print *out, uint32_t time_us, uint32_t raw_temp,
+                       uint32_t raw_pressure) {
+  uint8_t buffer[MS8607_CAPTURE_PT_LEN];
+
+  buffer[0] = MS8607_CAPTURE_PT;
+  put32(&buffer[1], time_us);
+  put24(&buffer[5], raw_temp);
+  put24(&buffer[8], raw_pressure);
+  return out->write(buffer, sizeof(buffer)) == sizeof(buffer);
+}
+
+/**
+ * @brief Add a humidity record to a capture
+ *
+ * @param out Where the capture is written
+ * @param time_us When the value was read, in microseconds
+ * @param raw The raw humidity value
+ * @return true: success false: the record could not be written
+ */
+bool ms8607_capture_humidity(Print *out, uint32_t time_us, uint16_t raw) {
+  uint8_t buffer[MS8607_CAPTURE_HUMIDITY_LEN];
+
+  buffer[0] = MS8607_CAPTURE_HUMIDITY;
+  put32(&buffer[1], time_us);
+  put16(&buffer[5], raw);
+  return out->write(buffer, sizeof(buffer)) == sizeof(buffer);
+}
+
+/**
+ * @brief Add a record of a read of temperature, pressure and humidity to a
+ * capture
+ *
+ * @param out Where the capture is written
+ * @param time_us When the temperature and pressure were read, in
+ * microseconds
+ * @param raw_temp The raw temperature (D2) value
+ * @param raw_pressure The raw pressure (D1) value
+ * @param humidity_time_us When the humidity was read, in microseconds
+ * @param raw_humidity The raw humidity value
+ * @return true: success false: the record could not be written
+ */
+bool ms8607_capture_pt_humidity(Print *out, uint32_t time_us,
+                                uint32_t raw_temp, uint32_t raw_pressure,
+                                uint32_t humidity_time_us,
+                                uint16_t raw_humidity) {
+  uint8_t buffer[MS8607_CAPTURE_PT_HUMIDITY_LEN];
+
+  buffer[0] = MS8607_CAPTURE_PT_HUMIDITY;
+  put32(&buffer[1], time_us);
+  put24(&buffer[5], raw_temp);
+  put24(&buffer[8], raw_pressure);
+  put32(&buffer[11], humidity_time_us);
+  put16(&buffer[15], raw_humidity);
+  return out->write(buffer, sizeof(buffer)) == sizeof(buffer);
+}
+
+/**
+ * @brief Check a capture's header and get the calibration constants in it
+ *
+ * @param capture The capture
+ * @param len The length of the capture in bytes
+ * @param calibration Where to store the calibration constants
+ * @return true: success false: not a capture this version can read, or its
+ * calibration fails the CRC check
+ */
+bool ms8607_capture_parse_header(const uint8_t *capture, size_t len,
+                                 ms8607_calibration_t *calibration) {
+  if (len < MS8607_CAPTURE_HEADER_LEN || capture[0] != 'M' ||
+      capture[1] != 'S' || capture[2] != '8' || capture[3] != '6' ||
+      capture[4] != MS8607_CAPTURE_VERSION) {
+    return false;
+  }
+  calibration->prom_crc = get16(&capture[5]);
+  calibration->press_sens = get16(&capture[7]);
+  calibration->press_offset = get16(&capture[9]);
+  calibration->press_sens_temp_coeff = get16(&capture[11]);
+  calibration->press_offset_temp_coeff = get16(&capture[13]);
+  calibration->ref_temp = get16(&capture[15]);
+  calibration->temp_temp_coeff = get16(&capture[17]);
+  return ms8607_check_calibration(calibration);
+}
+
+#ifdef MS8607_ENABLE_CAPTURE
+/**
+ * @brief Start writing the raw values of every conversion read to a capture,
+ * from any of the reading methods. Each read is written as it ends, so the
+ * output should be buffered, like a file, rather than a slow serial port.
+ * Temperature and pressure computed with computePressureTemperature() are
+ * held back until humidity is computed, the next temperature and pressure
+ * are, or stopCapture() is called
+ *
+ * @param out Where to write the capture
+ * @return true: success false: the calibration has not been read yet or the
+ * header could not be written
+ */
+bool Adafruit_MS8607::startCapture(Print *out) {
+  _capture = NULL;
+  if (!_calibration_loaded || !ms8607_capture_header(out, &_calibration)) {
+    return false;
+  }
+  _capture = out;
+  _capture_pt = false;
+  return true;
+}
+
+/**
+ * @brief Stop writing raw values to the capture, after writing any that are
+ * held back
+ *
+ */
+void Adafruit_MS8607::stopCapture(void) {
+  _capture_flush();
+  _capture = NULL;
+}
+
+/***************************  Private Methods *********************************/
+void Adafruit_MS8607::_capture_flush(void) {
+  if (_capture && _capture_pt) {
+    ms8607_capture_pt(_capture, _capture_time_us, _capture_raw_temp,
+                      _capture_raw_pressure);
+  }
+  _capture_pt = false;
+}
+#endif
@@ -0,0 +1,49 @@
+/*!
+ *  @file Adafruit_MS8607_Capture.h
+ *
+ *  Capture of raw MS8607 readings for replay. When MS8607_ENABLE_CAPTURE is
+ *  defined, Adafruit_MS8607 can write the PROM block and every raw D1, D2
+ *  and humidity word it reads to a Print, e.g. a file on an SD card.
+ *  Adafruit_MS8607_Replay feeds a capture back through the driver, so
+ *  processing of real-world data can be tested and benchmarked
+ *  deterministically on any host.
+ *
+ *  A capture is little-endian: a header of the magic bytes "MS86", the
+ *  format version and the seven PROM words, then one record per read, each
+ *  a type byte followed by a 32-bit timestamp in microseconds:
+ *   - MS8607_CAPTURE_PT: the 24-bit D2 then the 24-bit D1 value, 11 bytes
+ *   - MS8607_CAPTURE_HUMIDITY: the 16-bit raw humidity value, 7 bytes
+ *   - MS8607_CAPTURE_PT_HUMIDITY: a read of all three, the D2 and D1 values
+ *     then the humidity's own 32-bit timestamp and raw value, 17 bytes
+ *  so a replay knows which reads sampled humidity.
+ *
+ *  MIT license, all text above must be included in any redistribution
+ */
+
+#ifndef __MS8607_CAPTURE_H__
+#define __MS8607_CAPTURE_H__
+
+#include "Arduino.h"
+#include <Adafruit_MS8607_Compensation.h>
+
+#define MS8607_CAPTURE_VERSION 2         ///< Capture format version
+#define MS8607_CAPTURE_HEADER_LEN 19     ///< Bytes in the capture header
+#define MS8607_CAPTURE_PT 0x01           ///< Temperature & pressure record
+#define MS8607_CAPTURE_PT_LEN 11         ///< Bytes in a temperature record
+#define MS8607_CAPTURE_HUMIDITY 0x02     ///< Humidity record
+#define MS8607_CAPTURE_HUMIDITY_LEN 7    ///< Bytes in a humidity record
+#define MS8607_CAPTURE_PT_HUMIDITY 0x03  ///< Record of all three values
+#define MS8607_CAPTURE_PT_HUMIDITY_LEN 17 ///< Bytes in a record of all three
+
+bool ms8607_capture_header(Print *out, const ms8607_calibration_t *calibration);
+bool ms8607_capture_pt(Print *out, uint32_t time_us, uint32_t raw_temp,
+                       uint32_t raw_pressure);
+bool ms8607_capture_humidity(Print *out, uint32_t time_us, uint16_t raw);
+bool ms8607_capture_pt_humidity(Print *out, uint32_t time_us,
+                                uint32_t raw_temp, uint32_t raw_pressure,
+                                uint32_t humidity_time_us,
+                                uint16_t raw_humidity);
+bool ms8607_capture_parse_header(const uint8_t *capture, size_t len,
+                                 ms8607_calibration_t *calibration);
+
+#endif
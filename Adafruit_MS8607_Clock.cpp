@@ -0,0 +1,78 @@
+/*!
+ *  @file Adafruit_MS8607_Clock.cpp
+ *
+ *  Time sources used by the MS8607 driver
+ *
+ *  MIT license, all text above must be included in any redistribution
+ */
+
+#include <Adafruit_MS8607_Clock.h>
+
+/**
+ * @brief Get the current time from micros()
+ *
+ * @return uint32_t the time in microseconds
+ */
+uint32_t Adafruit_MS8607_ArduinoClock::micros(void) { return ::micros(); }
+
+/**
+ * @brief Get the current time from millis()
+ *
+ * @return uint32_t the time in milliseconds
+ */
+uint32_t Adafruit_MS8607_ArduinoClock::millis(void) { return ::millis(); }
+
+/**
+ * @brief Wait using delay() for whole milliseconds and delayMicroseconds()
+ * for the remainder
+ *
+ * @param us The time to wait in microseconds
+ */
+void Adafruit_MS8607_ArduinoClock::delayMicros(uint32_t us) {
+  if (us >= 1000) {
+    ::delay(us / 1000);
+  }
+  if (us % 1000) {
+    ::delayMicroseconds(us % 1000);
+  }
+}
+
+/**
+ * @brief Get the current virtual time
+ *
+ * @return uint32_t the time in microseconds
+ */
+uint32_t Adafruit_MS8607_VirtualClock::micros(void) { return _now_us; }
+
+/**
+ * @brief Advance the virtual time by the requested wait
+ *
+ * @param us The time to wait in microseconds
+ */
+void Adafruit_MS8607_VirtualClock::delayMicros(uint32_t us) {
+  _now_us += us;
+  _waited_us += us;
+}
+
+/**
+ * @brief Advance the virtual time without counting it as a wait, for example
+ * to account for time spent on the bus
+ *
+ * @param us The time to advance by in microseconds
+ */
+void Adafruit_MS8607_VirtualClock::advance(uint32_t us) { _now_us += us; }
+
+/**
+ * @brief Get the total time spent waiting in delayMicros()
+ *
+ * @return uint32_t the waited time in microseconds
+ */
+uint32_t Adafruit_MS8607_VirtualClock::waitedMicros(void) {
+  return _waited_us;
+}
+
+/**
+ * @brief Clear the total returned by waitedMicros()
+ *
+ */
+void Adafruit_MS8607_VirtualClock::resetWaited(void) { _waited_us = 0; }
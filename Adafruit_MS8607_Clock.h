@@ -0,0 +1,65 @@
+/*!
+ *  @file Adafruit_MS8607_Clock.h
+ *
+ *  Time sources used by the MS8607 driver for timestamps and conversion
+ *  waits. The default uses the Arduino timing functions; others can be
+ *  substituted with Adafruit_MS8607::setClock().
+ *
+ *  MIT license, all text above must be included in any redistribution
+ */
+
+#ifndef __MS8607_CLOCK_H__
+#define __MS8607_CLOCK_H__
+
+#include "Arduino.h"
+
+/**
+ * @brief Interface for the clock and delay functions used by the driver
+ *
+ */
+class Adafruit_MS8607_Clock {
+public:
+  virtual ~Adafruit_MS8607_Clock() {}
+
+  /** @brief Get the current time
+      @return uint32_t the time in microseconds */
+  virtual uint32_t micros(void) = 0;
+  /** @brief Get the current time
+      @return uint32_t the time in milliseconds */
+  virtual uint32_t millis(void) { return micros() / 1000; }
+  /** @brief Wait for a conversion or reset to complete
+      @param us The time to wait in microseconds */
+  virtual void delayMicros(uint32_t us) = 0;
+};
+
+/**
+ * @brief Clock using the Arduino micros(), millis() and delay() functions
+ *
+ */
+class Adafruit_MS8607_ArduinoClock : public Adafruit_MS8607_Clock {
+public:
+  uint32_t micros(void);
+  uint32_t millis(void);
+  void delayMicros(uint32_t us);
+};
+
+/**
+ * @brief Clock that only advances when told to, for host builds and
+ * deterministic benchmarks. Waits complete immediately and are totalled
+ * separately so bus time can be told apart from conversion time.
+ */
+class Adafruit_MS8607_VirtualClock : public Adafruit_MS8607_Clock {
+public:
+  uint32_t micros(void);
+  void delayMicros(uint32_t us);
+
+  void advance(uint32_t us);
+  uint32_t waitedMicros(void);
+  void resetWaited(void);
+
+private:
+  uint32_t _now_us = 0;    ///< The current virtual time
+  uint32_t _waited_us = 0; ///< Total time spent in delayMicros()
+};
+
+#endif
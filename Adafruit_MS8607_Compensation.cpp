@@ -0,0 +1,263 @@
+/*!
+ *  @file Adafruit_MS8607_Compensation.cpp
+ *
+ *  Calibration and conversion of raw MS8607 readings
+ *
+ *  MIT license, all text above must be included in any redistribution
+ */
+
+#include <Adafruit_MS8607.h>
+
+/**
+ * @brief Compute the CRC-4 of the pressure & temperature sensor's PROM,
+ * which is stored in the top 4 bits of word 0
+ *
+ * @param prom The PROM words 0 to 6. The CRC bits of word 0 are ignored
+ * @return uint8_t the CRC
+ */
+uint8_t ms8607_prom_crc(const uint16_t *prom) {
+  uint16_t n_rem = 0;
+
+  // word 0 without its CRC, words 1 to 6, then a word of zeros
+  for (uint8_t cnt = 0; cnt < (7 + 1) * 2; cnt++) {
+    uint16_t word = cnt < 2 ? prom[0] & 0x0FFF : cnt < 14 ? prom[cnt >> 1] : 0;
+
+    // Get next byte
+    if (cnt % 2 == 1)
+      n_rem ^= word & 0x00FF;
+    else
+      n_rem ^= word >> 8;
+
+    for (uint8_t n_bit = 8; n_bit > 0; n_bit--) {
+      if (n_rem & 0x8000)
+        n_rem = (n_rem << 1) ^ 0x3000;
+      else
+        n_rem <<= 1;
+    }
+  }
+  return (n_rem >> 12) & 0xF;
+}
+
+/**
+ * @brief Compute the CRC-8 the humidity sensor sends after its data,
+ * x^8 + x^5 + x^4 + 1
+ *
+ * @param data The bytes the CRC covers
+ * @param len The number of bytes
+ * @return uint8_t the CRC
+ */
+uint8_t ms8607_humidity_crc(const uint8_t *data, uint8_t len) {
+  uint8_t crc = 0;
+
+  for (uint8_t i = 0; i < len; i++) {
+    crc ^= data[i];
+    for (uint8_t n_bit = 8; n_bit > 0; n_bit--) {
+      if (crc & 0x80)
+        crc = (crc << 1) ^ 0x31;
+      else
+        crc <<= 1;
+    }
+  }
+  return crc;
+}
+
+/**
+ * @brief Read and CRC check the calibration constants from the pressure &
+ * temperature sensor's PROM. Each word needs its own command, so each is
+ * read in one write-then-read transaction, retried on a bus error
+ *
+ * @param pt_transport The bus interface for the pressure & temperature sensor
+ * @param calibration Where to store the calibration constants
+ * @return ms8607_status_t MS8607_OK on success, the error of the first word
+ * that could not be read, or MS8607_ERR_CRC
+ */
+ms8607_status_t
+ms8607_read_calibration(Adafruit_MS8607_Transport *pt_transport,
+                        ms8607_calibration_t *calibration) {
+  uint16_t buffer[7];
+  uint8_t cmd, data[2];
+  ms8607_status_t status;
+
+  for (uint8_t i = 0; i < 7; i++) {
+    cmd = PROM_ADDRESS_READ_ADDRESS_0 + 2 * i;
+    uint8_t retries = 0;
+    do {
+      status = pt_transport->write_then_read(&cmd, 1, data, 2);
+    } while (status != MS8607_OK && retries++ < MS8607_PROM_RETRIES);
+    if (status != MS8607_OK) {
+      return status;
+    }
+    buffer[i] = (uint16_t)data[0] << 8 | data[1];
+  }
+  return ms8607_parse_calibration(buffer, calibration);
+}
+
+/**
+ * @brief CRC check the seven words read from the PROM and store them as
+ * calibration constants, for callers that read the PROM themselves
+ *
+ * @param prom The PROM words, from address 0
+ * @param calibration Where to store the calibration constants
+ * @return ms8607_status_t MS8607_OK on success or MS8607_ERR_CRC
+ */
+ms8607_status_t ms8607_parse_calibration(const uint16_t *prom,
+                                         ms8607_calibration_t *calibration) {
+  if (ms8607_prom_crc(prom) != prom[0] >> 12) {
+    return MS8607_ERR_CRC;
+  }
+  calibration->prom_crc = prom[0];
+  calibration->press_sens = prom[1];
+  calibration->press_offset = prom[2];
+  calibration->press_sens_temp_coeff = prom[3];
+  calibration->press_offset_temp_coeff = prom[4];
+  calibration->ref_temp = prom[5];
+  calibration->temp_temp_coeff = prom[6];
+  return MS8607_OK;
+}
+
+/**
+ * @brief Check a copy of the calibration constants against its CRC, e.g.
+ * one restored from non-volatile memory
+ *
+ * @param calibration The calibration constants to check
+ * @return true: the CRC matches false: the copy is corrupt
+ */
+bool ms8607_check_calibration(const ms8607_calibration_t *calibration) {
+  uint16_t buffer[7];
+
+  buffer[0] = calibration->prom_crc;
+  buffer[1] = calibration->press_sens;
+  buffer[2] = calibration->press_offset;
+  buffer[3] = calibration->press_sens_temp_coeff;
+  buffer[4] = calibration->press_offset_temp_coeff;
+  buffer[5] = calibration->ref_temp;
+  buffer[6] = calibration->temp_temp_coeff;
+  return ms8607_prom_crc(buffer) == buffer[0] >> 12;
+}
+
+/**
+ * @brief Compensate raw temperature and pressure ADC values, including the
+ * second order temperature compensation
+ *
+ * @param calibration The sensor's calibration constants
+ * @param raw_temp The raw temperature (D2) value
+ * @param raw_pressure The raw pressure (D1) value
+ * @param temperature Where to store the temperature in hundredths of a
+ * degree C
+ * @param pressure Where to store the pressure in hundredths of a hPa
+ */
+void ms8607_compensate_pt(const ms8607_calibration_t *calibration,
+                          int32_t raw_temp, int32_t raw_pressure,
+                          int32_t *temperature, int32_t *pressure) {
+  int32_t dT, TEMP;
+  int64_t OFF, SENS, P, T2, OFF2, SENS2;
+  dT = (int32_t)raw_temp - ((int32_t)calibration->ref_temp << 8);
+
+  // Actual temperature = 2000 + dT * TEMPSENS
+  TEMP = 2000 + ((int64_t)dT * (int64_t)calibration->temp_temp_coeff >> 23);
+
+  // Second order temperature compensation
+  if (TEMP < 2000) {
+    T2 = (3 * ((int64_t)dT * (int64_t)dT)) >> 33;
+    OFF2 = 61 * ((int64_t)TEMP - 2000) * ((int64_t)TEMP - 2000) / 16;
+    SENS2 = 29 * ((int64_t)TEMP - 2000) * ((int64_t)TEMP - 2000) / 16;
+
+    if (TEMP < -1500) {
+      OFF2 += 17 * ((int64_t)TEMP + 1500) * ((int64_t)TEMP + 1500);
+      SENS2 += 9 * ((int64_t)TEMP + 1500) * ((int64_t)TEMP + 1500);
+    }
+  } else {
+    T2 = (5 * ((int64_t)dT * (int64_t)dT)) >> 38;
+    OFF2 = 0;
+    SENS2 = 0;
+  }
+
+  // OFF = OFF_T1 + TCO * dT
+  OFF = ((int64_t)(calibration->press_offset) << 17) +
+        (((int64_t)calibration->press_offset_temp_coeff * dT) >> 6);
+  OFF -= OFF2;
+
+  // Sensitivity at actual temperature = SENS_T1 + TCS * dT
+  SENS = ((int64_t)calibration->press_sens << 16) +
+         (((int64_t)calibration->press_sens_temp_coeff * dT) >> 7);
+  SENS -= SENS2;
+
+  // Temperature compensated pressure = D1 * SENS - OFF
+  P = (((raw_pressure * SENS) >> 21) - OFF) >> 15;
+
+  *temperature = TEMP - T2;
+  *pressure = P;
+}
+
+/**
+ * @brief CRC check the bytes of the humidity sensor's serial number and
+ * assemble it, for callers that read them themselves
+ *
+ * @param first The 8 bytes read with the first serial number command: the
+ * four SNB bytes each followed by their CRC
+ * @param last The 6 bytes read with the second: the two SNC bytes and the
+ * two SNA bytes, each pair followed by its CRC
+ * @param serial Where to store the serial number, SNA_1 in the top byte
+ * down to SNC_0 in the bottom one
+ * @return ms8607_status_t MS8607_OK on success or MS8607_ERR_CRC
+ */
+ms8607_status_t ms8607_parse_serial(const uint8_t *first, const uint8_t *last,
+                                    uint64_t *serial) {
+  uint32_t snb = 0;
+  uint16_t sna, snc;
+
+  for (uint8_t i = 0; i < 8; i += 2) {
+    if (ms8607_humidity_crc(&first[i], 1) != first[i + 1]) {
+      return MS8607_ERR_CRC;
+    }
+    snb = snb << 8 | first[i];
+  }
+  if (ms8607_humidity_crc(&last[0], 2) != last[2] ||
+      ms8607_humidity_crc(&last[3], 2) != last[5]) {
+    return MS8607_ERR_CRC;
+  }
+  snc = (uint16_t)last[0] << 8 | last[1];
+  sna = (uint16_t)last[3] << 8 | last[4];
+
+  *serial = (uint64_t)sna << 48 | (uint64_t)snb << 16 | snc;
+  return MS8607_OK;
+}
+
+/**
+ * @brief CRC check a humidity reading
+ *
+ * @param buffer The three bytes read from the humidity sensor
+ * @param raw Where to store the 16-bit raw humidity value
+ * @return true: success false: CRC mismatch
+ */
+bool ms8607_parse_humidity(const uint8_t *buffer, uint16_t *raw) {
+  if (ms8607_humidity_crc(buffer, 2) != buffer[2]) {
+    return false;
+  }
+  *raw = buffer[0] << 8 | buffer[1];
+  return true;
+}
+
+/**
+ * @brief Convert a raw humidity value
+ *
+ * @param raw The raw humidity value
+ * @return int32_t the relative humidity in hundredths of a %rH
+ */
+int32_t ms8607_compute_humidity(uint16_t raw) {
+  // RH = -6 + 125 * raw / 2^16
+  return (((int32_t)raw * 100 * HUMIDITY_COEFF_MUL) >> 16) +
+         100 * HUMIDITY_COEFF_ADD;
+}
+
+/**
+ * @brief Correct relative humidity for the temperature it was measured at
+ *
+ * @param humidity The relative humidity in hundredths of a %rH
+ * @param temperature The temperature in hundredths of a degree C
+ * @return int32_t the compensated relative humidity in hundredths of a %rH
+ */
+int32_t ms8607_compensate_humidity(int32_t humidity, int32_t temperature) {
+  // RH += (20 - T) * -0.15
+  return humidity - (2000 - temperature) * 15 / 100;
+}
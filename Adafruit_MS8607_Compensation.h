@@ -0,0 +1,52 @@
+/*!
+ *  @file Adafruit_MS8607_Compensation.h
+ *
+ *  Calibration and conversion of raw MS8607 readings, shared by
+ *  Adafruit_MS8607 and Adafruit_MS8607_Fixed. Results are integers in
+ *  hundredths of a degree C, hPa and %rH, so no floating point is needed
+ *
+ *  MIT license, all text above must be included in any redistribution
+ */
+
+#ifndef __MS8607_COMPENSATION_H__
+#define __MS8607_COMPENSATION_H__
+
+#include "Arduino.h"
+#include <Adafruit_MS8607_Transport.h>
+
+#define MS8607_PROM_RETRIES 2 ///< Extra attempts at each PROM word read
+                              ///< by ms8607_read_calibration()
+
+/**
+ * @brief Factory calibration constants of the pressure & temperature sensor,
+ * as stored in its PROM
+ *
+ */
+typedef struct {
+  uint16_t prom_crc;                ///< PROM word 0, CRC in the top 4 bits
+  uint16_t press_sens;              ///< C1, pressure sensitivity
+  uint16_t press_offset;            ///< C2, pressure offset
+  uint16_t press_sens_temp_coeff;   ///< C3, temperature coefficient of C1
+  uint16_t press_offset_temp_coeff; ///< C4, temperature coefficient of C2
+  uint16_t ref_temp;                ///< C5, reference temperature
+  uint16_t temp_temp_coeff; ///< C6, temperature coefficient of temperature
+} ms8607_calibration_t;
+
+uint8_t ms8607_prom_crc(const uint16_t *prom);
+uint8_t ms8607_humidity_crc(const uint8_t *data, uint8_t len);
+ms8607_status_t
+ms8607_read_calibration(Adafruit_MS8607_Transport *pt_transport,
+                        ms8607_calibration_t *calibration);
+ms8607_status_t ms8607_parse_calibration(const uint16_t *prom,
+                                         ms8607_calibration_t *calibration);
+bool ms8607_check_calibration(const ms8607_calibration_t *calibration);
+void ms8607_compensate_pt(const ms8607_calibration_t *calibration,
+                          int32_t raw_temp, int32_t raw_pressure,
+                          int32_t *temperature, int32_t *pressure);
+ms8607_status_t ms8607_parse_serial(const uint8_t *first, const uint8_t *last,
+                                    uint64_t *serial);
+bool ms8607_parse_humidity(const uint8_t *buffer, uint16_t *raw);
+int32_t ms8607_compute_humidity(uint16_t raw);
+int32_t ms8607_compensate_humidity(int32_t humidity, int32_t temperature);
+
+#endif
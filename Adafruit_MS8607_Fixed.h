@@ -0,0 +1,268 @@
+/*!
+ *  @file Adafruit_MS8607_Fixed.h
+ *
+ *  MS8607 driver with its configuration fixed at compile time. Command
+ *  bytes and conversion times are constants, so a read is a straight line
+ *  of bus transactions and waits with no branches on settings, and code
+ *  for unused modes is not compiled in.
+ *
+ *  MIT license, all text above must be included in any redistribution
+ */
+
+#ifndef __MS8607_FIXED_H__
+#define __MS8607_FIXED_H__
+
+#include <Adafruit_MS8607.h>
+
+/**
+ * @brief Driver for an MS8607 with a fixed configuration
+ *
+ * @tparam OSR The pressure & temperature oversampling ratio
+ * @tparam RES The humidity resolution
+ * @tparam HOLD true: hold the I2C clock during humidity conversions
+ * @tparam RH_COMPENSATION true: correct relative humidity for temperature
+ */
+template <
+    ms8607_pressure_resolution_t OSR = MS8607_PRESSURE_RESOLUTION_OSR_4096,
+    ms8607_humidity_resolution_t RES = MS8607_HUMIDITY_RESOLUTION_OSR_12b,
+    bool HOLD = false, bool RH_COMPENSATION = false>
+class Adafruit_MS8607_Fixed {
+public:
+  /** Command starting a temperature (D2) conversion */
+  static constexpr uint8_t TEMPERATURE_COMMAND =
+      PSENSOR_START_TEMPERATURE_ADC_CONVERSION | (OSR * 2);
+  /** Command starting a pressure (D1) conversion */
+  static constexpr uint8_t PRESSURE_COMMAND =
+      PSENSOR_START_PRESSURE_ADC_CONVERSION | (OSR * 2);
+  /** Command starting a humidity conversion */
+  static constexpr uint8_t HUMIDITY_COMMAND =
+      HOLD ? HSENSOR_READ_HUMIDITY_W_HOLD_COMMAND
+           : HSENSOR_READ_HUMIDITY_WO_HOLD_COMMAND;
+  /** Maximum pressure or temperature conversion time in microseconds */
+  static constexpr uint32_t PT_CONVERSION_TIME =
+      OSR == MS8607_PRESSURE_RESOLUTION_OSR_256
+          ? PSENSOR_CONVERSION_TIME_OSR_256
+      : OSR == MS8607_PRESSURE_RESOLUTION_OSR_512
+          ? PSENSOR_CONVERSION_TIME_OSR_512
+      : OSR == MS8607_PRESSURE_RESOLUTION_OSR_1024
+          ? PSENSOR_CONVERSION_TIME_OSR_1024
+      : OSR == MS8607_PRESSURE_RESOLUTION_OSR_2048
+          ? PSENSOR_CONVERSION_TIME_OSR_2048
+      : OSR == MS8607_PRESSURE_RESOLUTION_OSR_4096
+          ? PSENSOR_CONVERSION_TIME_OSR_4096
+          : PSENSOR_CONVERSION_TIME_OSR_8192;
+  /** Maximum humidity conversion time in microseconds */
+  static constexpr uint32_t HUMIDITY_CONVERSION_TIME =
+      RES == MS8607_HUMIDITY_RESOLUTION_OSR_8b
+          ? HSENSOR_CONVERSION_TIME_8b * 1000UL
+      : RES == MS8607_HUMIDITY_RESOLUTION_OSR_10b
+          ? HSENSOR_CONVERSION_TIME_10b * 1000UL
+      : RES == MS8607_HUMIDITY_RESOLUTION_OSR_11b
+          ? HSENSOR_CONVERSION_TIME_11b * 1000UL
+          : HSENSOR_CONVERSION_TIME_12b * 1000UL;
+
+  /** @brief Create a driver. Call begin() before reading */
+  Adafruit_MS8607_Fixed() { _clock = &_arduino_clock; }
+  ~Adafruit_MS8607_Fixed() { _release_transports(); }
+
+  /** @brief Set up the sensor on a TwoWire bus
+      @param wire The Wire object to be used for I2C connections
+      @return true: success false: failure */
+  bool begin(TwoWire *wire = &Wire) {
+    _release_transports();
+    _pt = new (_pt_transport_storage)
+        Adafruit_MS8607_I2CTransport(MS8607_PT_ADDRESS, wire);
+    _hum = new (_hum_transport_storage)
+        Adafruit_MS8607_I2CTransport(MS8607_HUM_ADDRESS, wire);
+    _owns_transports = true;
+    return _begin();
+  }
+
+  /** @brief Set up the sensor over caller-supplied bus interfaces, which
+      must outlive the driver
+      @param pt_transport The bus interface for the pressure & temperature
+      sensor
+      @param hum_transport The bus interface for the humidity sensor
+      @return true: success false: failure */
+  bool begin(Adafruit_MS8607_Transport *pt_transport,
+             Adafruit_MS8607_Transport *hum_transport) {
+    _release_transports();
+    _pt = pt_transport;
+    _hum = hum_transport;
+    return _begin();
+  }
+
+  /** @brief Set the time source used for conversion waits
+      @param clock The clock to use, or NULL to restore the Arduino timing
+      functions */
+  void setClock(Adafruit_MS8607_Clock *clock) {
+    _clock = clock ? clock : &_arduino_clock;
+  }
+
+  /** @brief Read pressure, temperature and optionally humidity
+      @param read_humidity true: read humidity as well
+      @return true: success false: failure */
+  bool read(bool read_humidity = true) {
+    uint32_t raw_temp, raw_pressure;
+    int32_t temperature, pressure;
+
+    // the results are only stored once the whole read has succeeded
+    if (!_convert(TEMPERATURE_COMMAND, &raw_temp) ||
+        !_convert(PRESSURE_COMMAND, &raw_pressure)) {
+      return false;
+    }
+    ms8607_compensate_pt(&_calibration, raw_temp, raw_pressure, &temperature,
+                         &pressure);
+    if (!read_humidity) {
+      _temperature = temperature;
+      _pressure = pressure;
+      return true;
+    }
+
+    uint8_t buffer[3];
+    uint16_t raw_hum;
+    buffer[0] = HUMIDITY_COMMAND;
+    if (HOLD) {
+      // the sensor holds SCL low until the conversion is done
+      if (!_check(_hum->write_then_read(buffer, 1, buffer, 3))) {
+        return false;
+      }
+    } else {
+      if (!_check(_hum->write(buffer, 1))) {
+        return false;
+      }
+      _clock->delayMicros(HUMIDITY_CONVERSION_TIME);
+      if (!_check(_hum->read(buffer, 3))) {
+        return false;
+      }
+    }
+    if (!ms8607_parse_humidity(buffer, &raw_hum)) {
+      _status = MS8607_ERR_CRC;
+      return false;
+    }
+    _temperature = temperature;
+    _pressure = pressure;
+    _humidity = ms8607_compute_humidity(raw_hum);
+    if (RH_COMPENSATION) {
+      _humidity = ms8607_compensate_humidity(_humidity, _temperature);
+    }
+    return true;
+  }
+
+  /** @brief Get the result of the most recent bus transaction or check of
+      the data read, which tells why a call that returned false failed
+      @return ms8607_status_t MS8607_OK if the last operation succeeded */
+  ms8607_status_t getStatus(void) { return _status; }
+
+  /** @brief Get the temperature from the last read()
+      @return int32_t the temperature in hundredths of a degree C */
+  int32_t getTemperatureX100(void) { return _temperature; }
+  /** @brief Get the pressure from the last read()
+      @return int32_t the pressure in hundredths of a hPa */
+  int32_t getPressureX100(void) { return _pressure; }
+  /** @brief Get the relative humidity from the last read()
+      @return int32_t the relative humidity in hundredths of a %rH */
+  int32_t getHumidityX100(void) { return _humidity; }
+#ifndef MS8607_NO_FLOAT
+  /** @brief Get the temperature from the last read()
+      @return float the temperature in degrees C */
+  float getTemperature(void) { return _temperature / 100.0f; }
+  /** @brief Get the pressure from the last read()
+      @return float the pressure in hPa */
+  float getPressure(void) { return _pressure / 100.0f; }
+  /** @brief Get the relative humidity from the last read()
+      @return float the relative humidity in %rH */
+  float getHumidity(void) { return _humidity / 100.0f; }
+#endif
+
+private:
+  bool _begin(void) {
+    uint8_t buffer[2];
+
+    if (!_check(_pt->begin()) || !_check(_hum->begin())) {
+      return false;
+    }
+    buffer[0] = P_T_RESET;
+    if (!_check(_pt->write(buffer, 1))) {
+      return false;
+    }
+    buffer[0] = HSENSOR_RESET_COMMAND;
+    if (!_check(_hum->write(buffer, 1))) {
+      return false;
+    }
+    _clock->delayMicros(15000);
+
+    if (!_check(ms8607_read_calibration(_pt, &_calibration))) {
+      return false;
+    }
+    if (RES == MS8607_HUMIDITY_RESOLUTION_OSR_12b) {
+      // already set by the reset
+      return true;
+    }
+    buffer[0] = HSENSOR_READ_USER_REG_COMMAND;
+    if (!_check(_hum->write_then_read(buffer, 1, &buffer[1], 1, true))) {
+      return false;
+    }
+    buffer[0] = HSENSOR_WRITE_USER_REG_COMMAND;
+    buffer[1] &= ~HSENSOR_USER_REG_RESOLUTION_MASK;
+    buffer[1] |= RES & HSENSOR_USER_REG_RESOLUTION_MASK;
+    return _check(_hum->write(buffer, 2));
+  }
+
+  bool _check(ms8607_status_t status) {
+    _status = status;
+    return status == MS8607_OK;
+  }
+
+  void _release_transports(void) {
+    if (_owns_transports) {
+      _pt->~Adafruit_MS8607_Transport();
+      _hum->~Adafruit_MS8607_Transport();
+    }
+    _pt = NULL;
+    _hum = NULL;
+    _owns_transports = false;
+  }
+
+  bool _convert(uint8_t command, uint32_t *raw) {
+    uint8_t buffer[3];
+
+    buffer[0] = command;
+    if (!_check(_pt->write(buffer, 1))) {
+      return false;
+    }
+    _clock->delayMicros(PT_CONVERSION_TIME);
+    buffer[0] = PSENSOR_READ_ADC;
+    if (!_check(_pt->write_then_read(buffer, 1, buffer, 3))) {
+      return false;
+    }
+    *raw = ((uint32_t)buffer[0] << 16) | ((uint32_t)buffer[1] << 8) | buffer[2];
+    if (*raw == 0) {
+      // the sensor gives 0 when no conversion result is ready
+      _status = MS8607_ERR_BUS;
+      return false;
+    }
+    return true;
+  }
+
+  Adafruit_MS8607_Transport *_pt = NULL;  ///< Pressure & temperature bus
+  Adafruit_MS8607_Transport *_hum = NULL; ///< Humidity bus
+  bool _owns_transports = false; ///< Whether begin() built the bus interfaces
+  alignas(Adafruit_MS8607_I2CTransport) uint8_t _pt_transport_storage[sizeof(
+      Adafruit_MS8607_I2CTransport)]; ///< Space for the built-in pressure &
+                                      ///< temperature bus interface
+  alignas(Adafruit_MS8607_I2CTransport) uint8_t _hum_transport_storage[sizeof(
+      Adafruit_MS8607_I2CTransport)]; ///< Space for the built-in humidity bus
+                                      ///< interface
+  Adafruit_MS8607_ArduinoClock _arduino_clock; ///< Default time source
+  Adafruit_MS8607_Clock *_clock;               ///< Time source for waits
+
+  ms8607_status_t _status = MS8607_OK; ///< Result of the last transaction
+
+  ms8607_calibration_t _calibration; ///< calibration constants
+  int32_t _temperature = 0; ///< The last temperature measurement, C x 100
+  int32_t _pressure = 0;    ///< The last pressure measurement, hPa x 100
+  int32_t _humidity = 0;    ///< The last humidity measurement, %rH x 100
+};
+
+#endif
@@ -0,0 +1,142 @@
+/*!
+ *  @file Adafruit_MS8607_LinuxI2C.cpp
+ *
+ *  MS8607 transport for Linux i2c-dev buses
+ *
+ *  MIT license, all text above must be included in any redistribution
+ */
+
+#include <Adafruit_MS8607_LinuxI2C.h>
+
+#if defined(__linux__) && !defined(ARDUINO)
+
+#include <errno.h>
+#include <fcntl.h>
+#include <linux/i2c-dev.h>
+#include <linux/i2c.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+
+/*!
+ *    @brief  Instantiates a transport for a device on an i2c-dev bus
+ *    @param  device Path of the bus device, e.g. "/dev/i2c-1". Must stay
+ *            valid for the life of the transport
+ *    @param  address The I2C address of the device
+ */
+Adafruit_MS8607_LinuxI2C::Adafruit_MS8607_LinuxI2C(const char *device,
+                                                   uint8_t address) {
+  _device = device;
+  _address = address;
+}
+
+Adafruit_MS8607_LinuxI2C::~Adafruit_MS8607_LinuxI2C() {
+  if (_fd >= 0) {
+    close(_fd);
+  }
+}
+
+/**
+ * @brief Open the bus and check the device acknowledges its address. The
+ * address is probed with a zero length write, which has no side effects,
+ * but only if the adapter supports SMBus quick commands. Adapters that
+ * reject zero length messages do not, and for them a missing device is
+ * only found by the first command
+ *
+ * @return ms8607_status_t MS8607_OK on success, MS8607_ERR_INVALID if the
+ * bus cannot be opened or does not support I2C_RDWR
+ */
+ms8607_status_t Adafruit_MS8607_LinuxI2C::begin(void) {
+  unsigned long funcs;
+
+  if (_fd < 0) {
+    _fd = open(_device, O_RDWR);
+    if (_fd < 0) {
+      return MS8607_ERR_INVALID;
+    }
+  }
+  if (ioctl(_fd, I2C_FUNCS, &funcs) < 0 || !(funcs & I2C_FUNC_I2C)) {
+    return MS8607_ERR_INVALID;
+  }
+  if (!(funcs & I2C_FUNC_SMBUS_QUICK)) {
+    return MS8607_OK;
+  }
+  return write(NULL, 0);
+}
+
+/**
+ * @brief Write to the device
+ *
+ * @param buffer The bytes to write
+ * @param len The number of bytes to write
+ * @return ms8607_status_t MS8607_OK on success
+ */
+ms8607_status_t Adafruit_MS8607_LinuxI2C::write(const uint8_t *buffer,
+                                                size_t len) {
+  struct i2c_msg message = {_address, 0, (uint16_t)len, (uint8_t *)buffer};
+  return _transfer(&message, 1);
+}
+
+/**
+ * @brief Read from the device
+ *
+ * @param buffer Where to store the bytes read
+ * @param len The number of bytes to read
+ * @return ms8607_status_t MS8607_OK on success
+ */
+ms8607_status_t Adafruit_MS8607_LinuxI2C::read(uint8_t *buffer, size_t len) {
+  struct i2c_msg message = {_address, I2C_M_RD, (uint16_t)len, buffer};
+  return _transfer(&message, 1);
+}
+
+/**
+ * @brief Write to the device then read from it. With a repeated start both
+ * go in a single ioctl, with a stop each gets its own
+ *
+ * @param write_buffer The bytes to write
+ * @param write_len The number of bytes to write
+ * @param read_buffer Where to store the bytes read
+ * @param read_len The number of bytes to read
+ * @param stop true: end the write with a stop condition, false: go straight
+ * on to the read with a repeated start
+ * @return ms8607_status_t MS8607_OK on success
+ */
+ms8607_status_t Adafruit_MS8607_LinuxI2C::write_then_read(
+    const uint8_t *write_buffer, size_t write_len, uint8_t *read_buffer,
+    size_t read_len, bool stop) {
+  if (stop) {
+    ms8607_status_t status = write(write_buffer, write_len);
+    if (status != MS8607_OK) {
+      return status;
+    }
+    return read(read_buffer, read_len);
+  }
+  struct i2c_msg messages[2] = {
+      {_address, 0, (uint16_t)write_len, (uint8_t *)write_buffer},
+      {_address, I2C_M_RD, (uint16_t)read_len, read_buffer},
+  };
+  return _transfer(messages, 2);
+}
+
+ms8607_status_t Adafruit_MS8607_LinuxI2C::_transfer(struct i2c_msg *messages,
+                                                    uint32_t count) {
+  if (_fd < 0) {
+    return MS8607_ERR_INVALID;
+  }
+  struct i2c_rdwr_ioctl_data data = {messages, count};
+  if (ioctl(_fd, I2C_RDWR, &data) == (int)count) {
+    return MS8607_OK;
+  }
+  switch (errno) {
+  case ENXIO:
+  case EREMOTEIO:
+    return MS8607_ERR_NACK;
+  case ETIMEDOUT:
+    return MS8607_ERR_TIMEOUT;
+  case EINVAL:
+    return MS8607_ERR_INVALID;
+  default:
+    return MS8607_ERR_BUS;
+  }
+}
+
+#endif
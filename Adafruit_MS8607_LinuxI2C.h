@@ -0,0 +1,45 @@
+/*!
+ *  @file Adafruit_MS8607_LinuxI2C.h
+ *
+ *  MS8607 transport for Linux i2c-dev buses such as /dev/i2c-1 on a
+ *  Raspberry Pi. Each transaction, including write-then-read, is issued as a
+ *  single I2C_RDWR ioctl.
+ *
+ *  MIT license, all text above must be included in any redistribution
+ */
+
+#ifndef __MS8607_LINUXI2C_H__
+#define __MS8607_LINUXI2C_H__
+
+#if defined(__linux__) && !defined(ARDUINO)
+
+#include <Adafruit_MS8607_Transport.h>
+
+struct i2c_msg;
+
+/**
+ * @brief Transport for a device on a Linux i2c-dev bus
+ *
+ */
+class Adafruit_MS8607_LinuxI2C final : public Adafruit_MS8607_Transport {
+public:
+  Adafruit_MS8607_LinuxI2C(const char *device, uint8_t address);
+  ~Adafruit_MS8607_LinuxI2C();
+
+  ms8607_status_t begin(void);
+  ms8607_status_t write(const uint8_t *buffer, size_t len);
+  ms8607_status_t read(uint8_t *buffer, size_t len);
+  ms8607_status_t write_then_read(const uint8_t *write_buffer,
+                                  size_t write_len, uint8_t *read_buffer,
+                                  size_t read_len, bool stop = false);
+
+private:
+  ms8607_status_t _transfer(struct i2c_msg *messages, uint32_t count);
+
+  const char *_device; ///< Path of the bus device, e.g. "/dev/i2c-1"
+  uint8_t _address;    ///< The I2C address of the device
+  int _fd = -1;        ///< Open file descriptor for the bus
+};
+
+#endif
+#endif
@@ -0,0 +1,106 @@
+/*!
+ *  @file Adafruit_MS8607_Log.cpp
+ *
+ *  Compact binary log of MS8607 samples
+ *
+ *  MIT license, all text above must be included in any redistribution
+ */
+
+#include <Adafruit_MS8607_Log.h>
+
+static uint8_t put_varint(uint8_t *buffer, uint32_t value) {
+  uint8_t len = 0;
+
+  while (value >= 0x80) {
+    buffer[len++] = (value & 0x7F) | 0x80;
+    value >>= 7;
+  }
+  buffer[len++] = value;
+  return len;
+}
+
+static uint8_t put_signed(uint8_t *buffer, int32_t value) {
+  // zigzag: 0, -1, 1, -2, ... map to 0, 1, 2, 3, ...
+  return put_varint(buffer, ((uint32_t)value << 1) ^ (uint32_t)(value >> 31));
+}
+
+/**
+ * @brief Start a log with its header
+ *
+ * @param out Where to write the log, e.g. a file on an SD card
+ * @param keyframe_interval Samples from one keyframe to the next. More
+ * keyframes make the log larger but lose less of it to damage
+ * @return true: success false: the header could not be written
+ */
+bool Adafruit_MS8607_LogWriter::begin(Print *out,
+                                      uint16_t keyframe_interval) {
+  const uint8_t header[5] = {'M', 'S', '8', 'L', MS8607_LOG_VERSION};
+
+  _out = out;
+  _interval = keyframe_interval;
+  _need_keyframe = true;
+  return _out->write(header, sizeof(header)) == sizeof(header);
+}
+
+/**
+ * @brief Add a sample to the log
+ *
+ * @param time_ms When the sample was taken, in milliseconds
+ * @param temperature The temperature in hundredths of a degree C
+ * @param pressure The pressure in hundredths of a hPa
+ * @param humidity The relative humidity in hundredths of a %rH
+ * @return true: success false: the record could not be written. The next
+ * record is a keyframe, so the log can still be decoded
+ */
+bool Adafruit_MS8607_LogWriter::write(uint32_t time_ms, int32_t temperature,
+                                      int32_t pressure, int32_t humidity) {
+  uint8_t buffer[MS8607_LOG_RECORD_MAX];
+  uint8_t len = 0;
+  int32_t sample[3] = {temperature, pressure, humidity};
+
+  // a change of -1 ms would be written as 0, the keyframe marker
+  if (_need_keyframe || _since_keyframe >= _interval ||
+      time_ms + 1 == _time_ms) {
+    buffer[len++] = 0;
+    len += put_varint(&buffer[len], time_ms);
+    for (uint8_t i = 0; i < 3; i++) {
+      len += put_signed(&buffer[len], sample[i]);
+    }
+    _since_keyframe = 0;
+  } else {
+    len += put_varint(&buffer[len], time_ms - _time_ms + 1);
+    for (uint8_t i = 0; i < 3; i++) {
+      // wraps like the decoder's sum, for changes too big for an int32_t
+      len += put_signed(&buffer[len],
+                        (int32_t)((uint32_t)sample[i] - _previous[i]));
+    }
+  }
+  _since_keyframe++;
+
+  _need_keyframe = _out->write(buffer, len) != len;
+  _time_ms = time_ms;
+  for (uint8_t i = 0; i < 3; i++) {
+    _previous[i] = sample[i];
+  }
+  return !_need_keyframe;
+}
+
+/**
+ * @brief Add a sensor's most recent results to the log
+ *
+ * @param sensor The sensor, after a successful read()
+ * @param time_ms When the sample was taken, in milliseconds
+ * @return true: success false: the record could not be written
+ */
+bool Adafruit_MS8607_LogWriter::write(Adafruit_MS8607 *sensor,
+                                      uint32_t time_ms) {
+  return write(time_ms, sensor->getTemperatureX100(),
+               sensor->getPressureX100(), sensor->getHumidityX100());
+}
+
+/**
+ * @brief Make the next record a keyframe, e.g. after samples were skipped or
+ * the clock was set
+ *
+ */
+void Adafruit_MS8607_LogWriter::keyframe(void) { _need_keyframe = true; }
@@ -0,0 +1,58 @@
+/*!
+ *  @file Adafruit_MS8607_Log.h
+ *
+ *  Compact binary log of MS8607 samples for long-term storage, e.g. on an
+ *  SD card. Samples are the driver's integer results, so nothing is lost to
+ *  rounding, and each channel is stored as the difference from the
+ *  previous sample, which for slowly changing weather data usually fits in
+ *  one byte. A typical sample takes 5 to 7 bytes against about 40 as CSV.
+ *  tools/ms8607_log.py decodes a log to CSV.
+ *
+ *  A log is the magic bytes "MS8L" and the format version, then one record
+ *  per sample. Numbers are LEB128 varints, and signed numbers are zigzag
+ *  encoded first so small negative values stay short:
+ *   - a sample record is the milliseconds since the previous sample plus
+ *     one, then the zigzag changes in temperature, pressure and humidity
+ *   - a keyframe record is a 0, the time in milliseconds, then the zigzag
+ *     temperature, pressure and humidity
+ *  Values are in hundredths of a degree C, hPa and %rH. Keyframes are
+ *  written regularly and after a failed write, which limits how far an
+ *  error in one value carries.
+ *
+ *  MIT license, all text above must be included in any redistribution
+ */
+
+#ifndef __MS8607_LOG_H__
+#define __MS8607_LOG_H__
+
+#include <Adafruit_MS8607.h>
+
+#define MS8607_LOG_VERSION 1 ///< Log format version
+#define MS8607_LOG_KEYFRAME_INTERVAL                                           \
+  64 ///< Default samples from one keyframe to the next
+#define MS8607_LOG_RECORD_MAX 21 ///< Longest possible record in bytes
+
+/**
+ * @brief Writes samples to a delta encoded log
+ *
+ */
+class Adafruit_MS8607_LogWriter {
+public:
+  bool begin(Print *out,
+             uint16_t keyframe_interval = MS8607_LOG_KEYFRAME_INTERVAL);
+  bool write(uint32_t time_ms, int32_t temperature, int32_t pressure,
+             int32_t humidity);
+  bool write(Adafruit_MS8607 *sensor, uint32_t time_ms);
+  void keyframe(void);
+
+private:
+  Print *_out = NULL;           ///< Where the log is written
+  uint16_t _interval = 0;       ///< Samples from one keyframe to the next
+  uint16_t _since_keyframe = 0; ///< Samples since the last keyframe
+  bool _need_keyframe = true;   ///< The next record must be a keyframe
+  uint32_t _time_ms = 0;        ///< Time of the previous sample
+  int32_t _previous[3];         ///< The previous sample's temperature,
+                                ///< pressure and humidity
+};
+
+#endif
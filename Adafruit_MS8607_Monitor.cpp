@@ -0,0 +1,242 @@
+/*!
+ *  @file Adafruit_MS8607_Monitor.cpp
+ *
+ *  Optional instrumentation of the MS8607 driver's bus transactions
+ *
+ *  MIT license, all text above must be included in any redistribution
+ */
+
+#include <Adafruit_MS8607.h>
+
+/**
+ * @brief Work out what kind of transaction is being made from its command
+ *
+ * @param is_pt true for the pressure & temperature sensor
+ * @param write_buffer The bytes written, NULL for a plain read
+ * @param write_len The number of bytes written
+ * @return ms8607_op_t the kind of transaction
+ */
+ms8607_op_t ms8607_classify_op(bool is_pt, const uint8_t *write_buffer,
+                               size_t write_len) {
+  uint8_t cmd = (write_buffer && write_len) ? write_buffer[0] : 0;
+
+  if (is_pt) {
+    if (cmd == PSENSOR_READ_ADC) {
+      return MS8607_OP_ADC_READ;
+    }
+    if ((cmd & 0xF0) == PROM_ADDRESS_READ_ADDRESS_0) {
+      return MS8607_OP_PROM_READ;
+    }
+    return MS8607_OP_PT_COMMAND;
+  }
+  if (!write_buffer || !write_len || cmd == MS8607_I2C_HOLD) {
+    return MS8607_OP_RH_READ;
+  }
+  if (cmd == HSENSOR_READ_USER_REG_COMMAND ||
+      cmd == HSENSOR_WRITE_USER_REG_COMMAND) {
+    return MS8607_OP_USER_REGISTER;
+  }
+  if (cmd == HSENSOR_READ_SERIAL_FIRST_8BYTES_COMMAND >> 8 ||
+      cmd == HSENSOR_READ_SERIAL_LAST_6BYTES_COMMAND >> 8) {
+    return MS8607_OP_SERIAL_READ;
+  }
+  return MS8607_OP_RH_COMMAND;
+}
+
+#ifdef MS8607_MONITOR
+
+/*!
+ *    @brief  Start the monitored transport. Not recorded
+ *    @return ms8607_status_t MS8607_OK on success
+ */
+ms8607_status_t Adafruit_MS8607::Monitor::begin(void) {
+  return _transport->begin();
+}
+
+/*!
+ *    @brief  Write through the monitored transport
+ *    @param  buffer The bytes to write
+ *    @param  len The number of bytes to write
+ *    @return ms8607_status_t MS8607_OK on success
+ */
+ms8607_status_t Adafruit_MS8607::Monitor::write(const uint8_t *buffer,
+                                                size_t len) {
+  uint32_t start_us = _driver->_clock->micros();
+  ms8607_status_t status = _transport->write(buffer, len);
+  _driver->_record(_is_pt, buffer, len, 0, start_us, status);
+  return status;
+}
+
+/*!
+ *    @brief  Read through the monitored transport
+ *    @param  buffer Where to store the bytes read
+ *    @param  len The number of bytes to read
+ *    @return ms8607_status_t MS8607_OK on success
+ */
+ms8607_status_t Adafruit_MS8607::Monitor::read(uint8_t *buffer, size_t len) {
+  uint32_t start_us = _driver->_clock->micros();
+  ms8607_status_t status = _transport->read(buffer, len);
+  _driver->_record(_is_pt, NULL, 0, len, start_us, status);
+  return status;
+}
+
+/*!
+ *    @brief  Write then read through the monitored transport
+ *    @param  write_buffer The bytes to write
+ *    @param  write_len The number of bytes to write
+ *    @param  read_buffer Where to store the bytes read
+ *    @param  read_len The number of bytes to read
+ *    @param  stop true: end the write with a stop condition
+ *    @return ms8607_status_t MS8607_OK on success
+ */
+ms8607_status_t Adafruit_MS8607::Monitor::write_then_read(
+    const uint8_t *write_buffer, size_t write_len, uint8_t *read_buffer,
+    size_t read_len, bool stop) {
+  uint32_t start_us = _driver->_clock->micros();
+  // the command is overwritten when the buffers are shared
+  uint8_t cmd[2] = {0, 0};
+  if (write_len) {
+    memcpy(cmd, write_buffer, write_len < 2 ? write_len : 2);
+  }
+  ms8607_status_t status = _transport->write_then_read(
+      write_buffer, write_len, read_buffer, read_len, stop);
+  _driver->_record(_is_pt, cmd, write_len, read_len, start_us, status);
+  return status;
+}
+
+// only the first two bytes of write_buffer are used
+void Adafruit_MS8607::_record(bool is_pt, const uint8_t *write_buffer,
+                              size_t write_len, size_t read_len,
+                              uint32_t start_us, ms8607_status_t status) {
+  // each of trace and stats only uses some of the arguments
+  (void)is_pt;
+  (void)write_buffer;
+  (void)write_len;
+  (void)read_len;
+  (void)start_us;
+  (void)status;
+#ifdef MS8607_ENABLE_TRACE
+  ms8607_trace_entry_t *entry = &_trace[_trace_next];
+  entry->time_us = start_us;
+  entry->command[0] = write_len > 0 ? write_buffer[0] : 0;
+  entry->command[1] = write_len > 1 ? write_buffer[1] : 0;
+  entry->lengths = (write_len < 15 ? write_len : 15) << 4;
+  entry->lengths |= read_len < 15 ? read_len : 15;
+  entry->status = status | (is_pt ? 0 : MS8607_TRACE_HUMIDITY);
+  _trace_next = (_trace_next + 1) & (MS8607_TRACE_LEN - 1);
+  if (_trace_count < MS8607_TRACE_LEN) {
+    _trace_count++;
+  }
+#endif
+#ifdef MS8607_ENABLE_STATS
+  ms8607_op_stats_t *op =
+      &_stats.ops[ms8607_classify_op(is_pt, write_buffer, write_len)];
+  uint32_t elapsed_us = _clock->micros() - start_us;
+
+  op->count++;
+  if (status != MS8607_OK) {
+    op->failures++;
+  }
+  op->total_us += elapsed_us;
+  if (elapsed_us < op->min_us) {
+    op->min_us = elapsed_us;
+  }
+  if (elapsed_us > op->max_us) {
+    op->max_us = elapsed_us;
+  }
+#endif
+}
+
+#endif // MS8607_MONITOR
+
+#ifdef MS8607_ENABLE_STATS
+/**
+ * @brief Get a snapshot of the transaction statistics
+ *
+ * @param stats Where to copy the statistics
+ */
+void Adafruit_MS8607::getStats(ms8607_stats_t *stats) {
+  *stats = _stats;
+  for (uint8_t i = 0; i < MS8607_OP_COUNT; i++) {
+    ms8607_op_stats_t *op = &stats->ops[i];
+    if (op->count) {
+      op->mean_us = op->total_us / op->count;
+    } else {
+      op->min_us = 0;
+    }
+  }
+}
+
+/**
+ * @brief Clear the transaction statistics
+ *
+ */
+void Adafruit_MS8607::resetStats(void) {
+  memset(&_stats, 0, sizeof(_stats));
+  for (uint8_t i = 0; i < MS8607_OP_COUNT; i++) {
+    _stats.ops[i].min_us = UINT32_MAX;
+  }
+}
+#endif
+
+#ifdef MS8607_ENABLE_TRACE
+static void print_hex(Print *out, uint32_t value, uint8_t digits) {
+  while (digits--) {
+    out->print((value >> (4 * digits)) & 0xF, HEX);
+  }
+}
+
+/**
+ * @brief Copy the trace, oldest transaction first
+ *
+ * @param entries Where to copy the entries
+ * @param max_entries The most entries to copy. The newest are kept if there
+ * are more
+ * @return uint16_t the number of entries copied
+ */
+uint16_t Adafruit_MS8607::getTrace(ms8607_trace_entry_t *entries,
+                                   uint16_t max_entries) {
+  uint16_t count = _trace_count < max_entries ? _trace_count : max_entries;
+  uint16_t index = (_trace_next - count) & (MS8607_TRACE_LEN - 1);
+
+  for (uint16_t i = 0; i < count; i++) {
+    entries[i] = _trace[index];
+    index = (index + 1) & (MS8607_TRACE_LEN - 1);
+  }
+  return count;
+}
+
+/**
+ * @brief Print the trace, oldest transaction first, as lines of hex for
+ * tools/ms8607_trace.py to decode
+ *
+ * @param out Where to print, e.g. &Serial
+ */
+void Adafruit_MS8607::dumpTrace(Print *out) {
+  uint16_t index = (_trace_next - _trace_count) & (MS8607_TRACE_LEN - 1);
+
+  for (uint16_t i = 0; i < _trace_count; i++) {
+    ms8607_trace_entry_t *entry = &_trace[index];
+    out->print("MS8607 ");
+    print_hex(out, entry->time_us, 8);
+    out->print(' ');
+    print_hex(out, entry->command[0], 2);
+    print_hex(out, entry->command[1], 2);
+    out->print(' ');
+    print_hex(out, entry->lengths, 2);
+    out->print(' ');
+    print_hex(out, entry->status, 2);
+    out->println();
+    index = (index + 1) & (MS8607_TRACE_LEN - 1);
+  }
+}
+
+/**
+ * @brief Empty the trace
+ *
+ */
+void Adafruit_MS8607::clearTrace(void) {
+  _trace_next = 0;
+  _trace_count = 0;
+}
+#endif
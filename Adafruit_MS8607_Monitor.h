@@ -0,0 +1,77 @@
+/*!
+ *  @file Adafruit_MS8607_Monitor.h
+ *
+ *  Optional instrumentation of the MS8607 driver's bus transactions. When
+ *  MS8607_ENABLE_STATS is defined, Adafruit_MS8607 counts the transactions
+ *  of each kind it makes and times them. When MS8607_ENABLE_TRACE is
+ *  defined, it keeps the most recent transactions in a ring buffer for
+ *  post-mortem analysis. Without either, none of this is compiled in.
+ *
+ *  MIT license, all text above must be included in any redistribution
+ */
+
+#ifndef __MS8607_MONITOR_H__
+#define __MS8607_MONITOR_H__
+
+#include "Arduino.h"
+
+#if defined(MS8607_ENABLE_STATS) || defined(MS8607_ENABLE_TRACE)
+#define MS8607_MONITOR ///< Transactions are routed through a monitor
+#endif
+
+#ifndef MS8607_TRACE_LEN
+#define MS8607_TRACE_LEN 32 ///< Trace entries kept, must be a power of 2
+#endif
+#define MS8607_TRACE_HUMIDITY 0x80 ///< Trace status flag for the humidity die
+
+/**
+ * @brief Kinds of bus transaction, told apart by their command byte
+ *
+ */
+typedef enum {
+  MS8607_OP_PT_COMMAND,    ///< Pressure & temperature reset or conversion
+  MS8607_OP_ADC_READ,      ///< Pressure & temperature ADC read
+  MS8607_OP_PROM_READ,     ///< Calibration PROM word read
+  MS8607_OP_RH_COMMAND,    ///< Humidity reset or no-hold conversion
+  MS8607_OP_RH_READ,       ///< Humidity result read, or hold conversion
+  MS8607_OP_USER_REGISTER, ///< Humidity user register read or write
+  MS8607_OP_SERIAL_READ,   ///< Humidity serial number read
+  MS8607_OP_COUNT,         ///< Number of kinds of transaction
+} ms8607_op_t;
+
+/**
+ * @brief Counts and latencies of one kind of transaction
+ *
+ */
+typedef struct {
+  uint32_t count;    ///< Transactions made
+  uint32_t failures; ///< Transactions that did not return MS8607_OK
+  uint32_t min_us;   ///< Shortest transaction in microseconds
+  uint32_t max_us;   ///< Longest transaction in microseconds
+  uint32_t mean_us;  ///< Mean transaction time in microseconds
+  uint32_t total_us; ///< Total time spent in these transactions
+} ms8607_op_stats_t;
+
+/**
+ * @brief Transaction statistics for a sensor, indexed by ms8607_op_t
+ *
+ */
+typedef struct {
+  ms8607_op_stats_t ops[MS8607_OP_COUNT]; ///< Statistics for each kind
+} ms8607_stats_t;
+
+/**
+ * @brief One transaction in the trace, 8 bytes
+ *
+ */
+typedef struct {
+  uint32_t time_us;   ///< When the transaction started
+  uint8_t command[2]; ///< The first bytes written, 0 if not written
+  uint8_t lengths;    ///< Bytes written in the high nibble, read in the low
+  uint8_t status;     ///< ms8607_status_t, ORed with MS8607_TRACE_HUMIDITY
+} ms8607_trace_entry_t;
+
+ms8607_op_t ms8607_classify_op(bool is_pt, const uint8_t *write_buffer,
+                               size_t write_len);
+
+#endif
@@ -0,0 +1,170 @@
+/*!
+ *  @file Adafruit_MS8607_MuxArray.h
+ *
+ *  Manager for many MS8607 sensors behind TCA9548A-style I2C multiplexers.
+ *  Both MS8607 dies have fixed addresses, so each sensor needs a mux channel
+ *  of its own. Sensors are visited in mux/channel order to keep channel
+ *  switches to a minimum, and conversions are pipelined so all sensors
+ *  sample in about the time one sensor takes.
+ *
+ *  MIT license, all text above must be included in any redistribution
+ */
+
+#ifndef __MS8607_MUXARRAY_H__
+#define __MS8607_MUXARRAY_H__
+
+#include <Adafruit_MS8607.h>
+#include <Adafruit_MS8607_Pipeline.h>
+
+#define TCA9548A_DEFAULT_ADDRESS 0x70 ///< Default multiplexer address
+#define TCA9548A_CHANNELS 8           ///< Channels on each multiplexer
+
+/**
+ * @brief Owns N MS8607 sensors, each routed through a multiplexer channel
+ *
+ * @tparam N The number of sensors
+ */
+template <uint8_t N> class Adafruit_MS8607_MuxArray {
+public:
+  /** @brief Create a sensor array. Routes default to consecutive channels on
+      consecutive multiplexers starting at TCA9548A_DEFAULT_ADDRESS
+      @param wire The bus the multiplexers are on */
+  Adafruit_MS8607_MuxArray(TwoWire *wire = &Wire) {
+    _wire = wire;
+    for (uint8_t i = 0; i < N; i++) {
+      _mux[i] = TCA9548A_DEFAULT_ADDRESS + i / TCA9548A_CHANNELS;
+      _channel[i] = i % TCA9548A_CHANNELS;
+      _ok[i] = false;
+    }
+    _pipeline.setSelectCallback(_select_slot, this);
+  }
+
+  /** @brief Set the multiplexer channel a sensor is connected to. Must be
+      called before begin()
+      @param index The sensor index
+      @param mux_address The I2C address of the multiplexer
+      @param channel The multiplexer channel, 0-7
+      @return true: success false: invalid index or channel */
+  bool setRoute(uint8_t index, uint8_t mux_address, uint8_t channel) {
+    if (index >= N || channel >= TCA9548A_CHANNELS) {
+      return false;
+    }
+    _mux[index] = mux_address;
+    _channel[index] = channel;
+    return true;
+  }
+
+  /** @brief Initialize every sensor
+      @return true if every sensor was found and initialized. Sensors that
+      failed are skipped by read(); check them with ok() */
+  bool begin(void) {
+    bool all_ok = true;
+
+    _sort();
+    _selected_mux = 0;
+    _selected_mask = 0;
+    for (uint8_t i = 0; i < N; i++) {
+      uint8_t s = _order[i];
+      _ok[s] = _select(s) && _sensors[s].begin(_wire);
+      // pipeline slots follow the visiting order so starts stay grouped
+      _pipeline.setSensor(i, _ok[s] ? &_sensors[s] : NULL);
+      all_ok &= _ok[s];
+    }
+    return all_ok;
+  }
+
+  /** @brief Read pressure, temperature and humidity from every working
+      sensor, overlapping their conversions. Results are available from
+      each sensor's getPressure(), getTemperature() and getHumidity()
+      @return true if every sensor was read successfully */
+  bool read(void) { return _pipeline.read(); }
+
+  /** @brief Select a sensor's channel so it can be used directly
+      @param index The sensor index
+      @return true: success false: the multiplexer did not respond */
+  bool select(uint8_t index) { return index < N && _select(index); }
+
+  /** @brief Get a sensor. Use select() before talking to it directly
+      @param index The sensor index
+      @return Adafruit_MS8607* the sensor */
+  Adafruit_MS8607 *getSensor(uint8_t index) { return &_sensors[index]; }
+
+  /** @brief Check whether a sensor's last read succeeded
+      @param index The sensor index
+      @return true if the sensor's results are fresh */
+  bool ok(uint8_t index) {
+    for (uint8_t i = 0; i < N; i++) {
+      if (_order[i] == index) {
+        return _pipeline.ok(i);
+      }
+    }
+    return false;
+  }
+
+  /** @brief Get the number of multiplexer writes made so far
+      @return uint32_t the number of channel select transactions */
+  uint32_t channelSwitches(void) { return _switches; }
+
+private:
+  // visit sensors grouped by multiplexer, then by channel
+  void _sort(void) {
+    for (uint8_t i = 0; i < N; i++) {
+      uint8_t j = i;
+      while (j > 0 && _route_key(_order[j - 1]) > _route_key(i)) {
+        _order[j] = _order[j - 1];
+        j--;
+      }
+      _order[j] = i;
+    }
+  }
+
+  uint16_t _route_key(uint8_t index) {
+    return ((uint16_t)_mux[index] << 8) | _channel[index];
+  }
+
+  bool _select(uint8_t index) {
+    uint8_t mask = 1 << _channel[index];
+    if (_selected_mux == _mux[index] && _selected_mask == mask) {
+      return true;
+    }
+    // a channel left open on another mux would put a second sensor on the
+    // bus at the same addresses
+    if (_selected_mux && _selected_mux != _mux[index]) {
+      if (!_write_mux(_selected_mux, 0)) {
+        return false;
+      }
+    }
+    _selected_mux = 0;
+    if (!_write_mux(_mux[index], mask)) {
+      return false;
+    }
+    _selected_mux = _mux[index];
+    _selected_mask = mask;
+    return true;
+  }
+
+  bool _write_mux(uint8_t address, uint8_t mask) {
+    _switches++;
+    _wire->beginTransmission(address);
+    _wire->write(mask);
+    return _wire->endTransmission() == 0;
+  }
+
+  static bool _select_slot(uint8_t slot, void *context) {
+    Adafruit_MS8607_MuxArray *array = (Adafruit_MS8607_MuxArray *)context;
+    return array->_select(array->_order[slot]);
+  }
+
+  TwoWire *_wire;                        ///< The bus the multiplexers are on
+  Adafruit_MS8607 _sensors[N];           ///< The sensors
+  Adafruit_MS8607_Pipeline<N> _pipeline; ///< Reads sensors in visiting order
+  uint8_t _mux[N];                       ///< Multiplexer address of each sensor
+  uint8_t _channel[N];                   ///< Multiplexer channel of each sensor
+  uint8_t _order[N];                     ///< Sensor indexes in visiting order
+  bool _ok[N];                           ///< Whether each sensor initialized
+  uint8_t _selected_mux = 0;   ///< Multiplexer with an open channel, or 0
+  uint8_t _selected_mask = 0;  ///< Channel mask open on _selected_mux
+  uint32_t _switches = 0;      ///< Count of multiplexer writes
+};
+
+#endif
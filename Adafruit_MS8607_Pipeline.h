@@ -0,0 +1,209 @@
+/*!
+ *  @file Adafruit_MS8607_Pipeline.h
+ *
+ *  Pipelined reads across several MS8607 sensors. Every sensor is told to
+ *  start converting, then results are collected in the order conversions
+ *  finish and each sensor's next conversion is started straight away, so
+ *  the bus is only idle when every sensor is busy converting.
+ *
+ *  MIT license, all text above must be included in any redistribution
+ */
+
+#ifndef __MS8607_PIPELINE_H__
+#define __MS8607_PIPELINE_H__
+
+#include <Adafruit_MS8607.h>
+
+/** Callback that makes a sensor reachable, e.g. by switching a mux channel */
+typedef bool (*ms8607_select_callback_t)(uint8_t index, void *context);
+
+/**
+ * @brief Reads up to N sensors with their conversions overlapped
+ *
+ * @tparam N The maximum number of sensors
+ */
+template <uint8_t N> class Adafruit_MS8607_Pipeline {
+public:
+  /** @brief Create an empty pipeline */
+  Adafruit_MS8607_Pipeline() {
+    for (uint8_t i = 0; i < N; i++) {
+      _sensors[i] = NULL;
+      _ok[i] = false;
+    }
+  }
+
+  /** @brief Add or remove a sensor. Sensors may be on different buses, and
+      may use different resolutions
+      @param index The slot to use
+      @param sensor The sensor, already started with begin(), or NULL to
+      leave the slot empty
+      @return true: success false: invalid index */
+  bool setSensor(uint8_t index, Adafruit_MS8607 *sensor) {
+    if (index >= N) {
+      return false;
+    }
+    _sensors[index] = sensor;
+    return true;
+  }
+
+  /** @brief Set a function called before each transaction with a sensor, for
+      sensors that share addresses behind a multiplexer
+      @param callback Called with the sensor index, returning false if the
+      sensor could not be selected. NULL if no selection is needed
+      @param context A pointer passed to each call of the callback */
+  void setSelectCallback(ms8607_select_callback_t callback,
+                         void *context = NULL) {
+    _select_callback = callback;
+    _select_context = context;
+  }
+
+  /** @brief Read every sensor. Results are available from each sensor's
+      getPressure(), getTemperature() and getHumidity()
+      @param read_humidity true: read humidity as well as pressure and
+      temperature
+      @return true if every sensor was read successfully */
+  bool read(bool read_humidity = true) {
+    bool all_ok = true;
+
+    for (uint8_t i = 0; i < N; i++) {
+      _step[i] = MS8607_PIPELINE_DONE;
+      _ok[i] = false;
+      if (!_sensors[i]) {
+        continue;
+      }
+      if (!_select(i) || !_sensors[i]->startTemperatureConversion()) {
+        all_ok = false;
+        continue;
+      }
+      _step[i] = MS8607_PIPELINE_TEMPERATURE;
+      _set_deadline(i, _sensors[i]->getPTConversionTime());
+    }
+
+    int16_t next;
+    while ((next = _earliest()) >= 0) {
+      uint8_t i = next;
+      int32_t remaining_us = _remaining(i);
+      if (remaining_us > 0) {
+        _sensors[i]->getClock()->delayMicros(remaining_us);
+      }
+      if (!_select(i) || !_advance(i, read_humidity)) {
+        _step[i] = MS8607_PIPELINE_DONE;
+        all_ok = false;
+        continue;
+      }
+      if (_step[i] == MS8607_PIPELINE_DONE) {
+        _ok[i] = true;
+      } else {
+        _set_deadline(i, _conversion_time(i));
+      }
+    }
+    return all_ok;
+  }
+
+  /** @brief Check whether a sensor was read successfully by the last read()
+      @param index The sensor slot
+      @return true if the sensor's results are fresh */
+  bool ok(uint8_t index) { return index < N && _ok[index]; }
+
+private:
+  /** Next result to collect from each sensor */
+  typedef enum {
+    MS8607_PIPELINE_DONE,
+    MS8607_PIPELINE_TEMPERATURE,
+    MS8607_PIPELINE_PRESSURE,
+    MS8607_PIPELINE_HUMIDITY,
+  } ms8607_pipeline_step_t;
+
+  bool _select(uint8_t index) {
+    return !_select_callback || _select_callback(index, _select_context);
+  }
+
+  // the busy sensor whose conversion finishes first, or -1 when all are done
+  int16_t _earliest(void) {
+    int16_t earliest = -1;
+    int32_t earliest_us = 0;
+    for (uint8_t i = 0; i < N; i++) {
+      if (_step[i] == MS8607_PIPELINE_DONE) {
+        continue;
+      }
+      int32_t remaining_us = _remaining(i);
+      if (earliest < 0 || remaining_us < earliest_us) {
+        earliest = i;
+        earliest_us = remaining_us;
+      }
+    }
+    return earliest;
+  }
+
+  // deadlines are kept on each sensor's own clock, as sensors may not share
+  // one, and only compared as the time left
+  void _set_deadline(uint8_t index, uint32_t conversion_us) {
+    _deadline_us[index] = _sensors[index]->getClock()->micros() + conversion_us;
+  }
+
+  int32_t _remaining(uint8_t index) {
+    return (int32_t)(_deadline_us[index] -
+                     _sensors[index]->getClock()->micros());
+  }
+
+  uint32_t _conversion_time(uint8_t index) {
+    if (_step[index] == MS8607_PIPELINE_HUMIDITY) {
+      return _sensors[index]->getHumidityConversionTime();
+    }
+    return _sensors[index]->getPTConversionTime();
+  }
+
+  // collect a finished conversion and start the sensor's next one
+  bool _advance(uint8_t index, bool read_humidity) {
+    Adafruit_MS8607 *sensor = _sensors[index];
+    uint32_t raw_pressure;
+    uint16_t raw_hum;
+
+    switch (_step[index]) {
+    case MS8607_PIPELINE_TEMPERATURE:
+      if (!sensor->readPTConversion(&_raw_temp[index]) ||
+          !sensor->startPressureConversion()) {
+        return false;
+      }
+      _step[index] = MS8607_PIPELINE_PRESSURE;
+      return true;
+
+    case MS8607_PIPELINE_PRESSURE:
+      if (!sensor->readPTConversion(&raw_pressure) ||
+          !sensor->computePressureTemperature(_raw_temp[index],
+                                              raw_pressure)) {
+        return false;
+      }
+      if (!read_humidity) {
+        _step[index] = MS8607_PIPELINE_DONE;
+        return true;
+      }
+      if (!sensor->startHumidityConversion()) {
+        return false;
+      }
+      _step[index] = MS8607_PIPELINE_HUMIDITY;
+      return true;
+
+    case MS8607_PIPELINE_HUMIDITY:
+      if (!sensor->readHumidityConversion(&raw_hum) ||
+          !sensor->computeHumidity(raw_hum)) {
+        return false;
+      }
+      _step[index] = MS8607_PIPELINE_DONE;
+      return true;
+
+    default:
+      return false;
+    }
+  }
+
+  Adafruit_MS8607 *_sensors[N]; ///< The sensors, NULL for empty slots
+  uint8_t _step[N];             ///< Next result to collect from each sensor
+  uint32_t _deadline_us[N];     ///< When each conversion finishes
+  uint32_t _raw_temp[N];        ///< Raw temperatures of the current read
+  bool _ok[N];                  ///< Whether each sensor's last read worked
+  ms8607_select_callback_t _select_callback = NULL; ///< Selects a sensor
+  void *_select_context = NULL; ///< Passed to _select_callback
+};
+
+#endif
@@ -0,0 +1,352 @@
+/*!
+ *  @file Adafruit_MS8607_Replay.cpp
+ *
+ *  Replay of a capture of raw MS8607 readings
+ *
+ *  MIT license, all text above must be included in any redistribution
+ */
+
+#include <Adafruit_MS8607.h>
+#include <Adafruit_MS8607_Replay.h>
+
+static uint16_t get16(const uint8_t *buffer) {
+  return buffer[0] | (uint16_t)buffer[1] << 8;
+}
+
+static uint32_t get24(const uint8_t *buffer) {
+  return buffer[0] | (uint32_t)buffer[1] << 8 | (uint32_t)buffer[2] << 16;
+}
+
+static uint32_t get32(const uint8_t *buffer) {
+  return get24(buffer) | (uint32_t)buffer[3] << 24;
+}
+
+/*!
+ *    @brief  Instantiates a replay of a capture
+ *    @param  capture The capture, which must outlive the replay
+ *    @param  len The length of the capture in bytes
+ */
+Adafruit_MS8607_Replay::Adafruit_MS8607_Replay(const uint8_t *capture,
+                                               size_t len)
+    : _pt(this, true), _hum(this, false) {
+  ms8607_calibration_t calibration;
+
+  memset(&calibration, 0, sizeof(calibration));
+  _capture = capture;
+  _len = len;
+  _valid = ms8607_capture_parse_header(capture, len, &calibration);
+  _prom[0] = calibration.prom_crc;
+  _prom[1] = calibration.press_sens;
+  _prom[2] = calibration.press_offset;
+  _prom[3] = calibration.press_sens_temp_coeff;
+  _prom[4] = calibration.press_offset_temp_coeff;
+  _prom[5] = calibration.ref_temp;
+  _prom[6] = calibration.temp_temp_coeff;
+  rewind();
+}
+
+/**
+ * @brief Get the transport for the pressure & temperature die
+ *
+ * @return Adafruit_MS8607_Transport* the transport to pass to begin()
+ */
+Adafruit_MS8607_Transport *Adafruit_MS8607_Replay::getPTTransport(void) {
+  return &_pt;
+}
+
+/**
+ * @brief Get the transport for the humidity die
+ *
+ * @return Adafruit_MS8607_Transport* the transport to pass to begin()
+ */
+Adafruit_MS8607_Transport *Adafruit_MS8607_Replay::getHumidityTransport(void) {
+  return &_hum;
+}
+
+/**
+ * @brief Check the capture could be read. The transports' begin() fails if
+ * it could not
+ *
+ * @return true: the header is good false: not a capture, a version this
+ * library cannot read, or the calibration fails its CRC check
+ */
+bool Adafruit_MS8607_Replay::isValid(void) { return _valid; }
+
+/**
+ * @brief Check whether every record has been replayed. Conversions started
+ * after the end are not acknowledged
+ *
+ * @return true: all records have been replayed false: records remain
+ */
+bool Adafruit_MS8607_Replay::atEnd(void) {
+  size_t offset = _offset;
+
+  if (!_temp_used || !_pressure_used) {
+    return false;
+  }
+  return !_next(&offset);
+}
+
+/**
+ * @brief Check whether the read being replayed sampled humidity when it was
+ * captured, or the next read once both its temperature and pressure have
+ * been converted. Passing this to read() keeps the replay in step with the
+ * capture
+ *
+ * @return true: the read has a humidity value false: it has none, or no
+ * reads remain
+ */
+bool Adafruit_MS8607_Replay::hasHumidity(void) {
+  size_t offset = _offset;
+  const uint8_t *record;
+
+  if (!_temp_used || !_pressure_used) {
+    return _hum_ready;
+  }
+  record = _next_pt(&offset);
+  return record && record[0] == MS8607_CAPTURE_PT_HUMIDITY;
+}
+
+/**
+ * @brief Start replaying from the first record again
+ *
+ */
+void Adafruit_MS8607_Replay::rewind(void) {
+  _offset = MS8607_CAPTURE_HEADER_LEN;
+  _pt_record = NULL;
+  _temp_used = true;
+  _pressure_used = true;
+  _hum_ready = false;
+  _hum_pending = false;
+  _hum_time = 0;
+}
+
+/**
+ * @brief Get when the temperature & pressure being replayed were captured
+ *
+ * @return uint32_t the captured timestamp in microseconds, 0 before the
+ * first conversion
+ */
+uint32_t Adafruit_MS8607_Replay::getPTTime(void) {
+  return _pt_record ? get32(&_pt_record[1]) : 0;
+}
+
+/**
+ * @brief Get when the humidity being replayed was captured
+ *
+ * @return uint32_t the captured timestamp in microseconds, 0 before the
+ * first conversion
+ */
+uint32_t Adafruit_MS8607_Replay::getHumidityTime(void) { return _hum_time; }
+
+/*!
+ *    @brief  The replayed device acknowledges its address if the capture
+ *            is good
+ *    @return ms8607_status_t MS8607_OK on success
+ */
+ms8607_status_t Adafruit_MS8607_Replay::Port::begin(void) {
+  return _replay->_valid ? MS8607_OK : MS8607_ERR_INVALID;
+}
+
+/*!
+ *    @brief  Write to the replayed die
+ *    @param  buffer The bytes to write
+ *    @param  len The number of bytes to write
+ *    @return ms8607_status_t MS8607_OK on success
+ */
+ms8607_status_t Adafruit_MS8607_Replay::Port::write(const uint8_t *buffer,
+                                                    size_t len) {
+  return write_then_read(buffer, len, NULL, 0);
+}
+
+/*!
+ *    @brief  Read from the replayed die
+ *    @param  buffer Where to store the bytes read
+ *    @param  len The number of bytes to read
+ *    @return ms8607_status_t MS8607_OK on success
+ */
+ms8607_status_t Adafruit_MS8607_Replay::Port::read(uint8_t *buffer,
+                                                   size_t len) {
+  return write_then_read(NULL, 0, buffer, len);
+}
+
+/*!
+ *    @brief  Write to the replayed die then read from it
+ *    @param  write_buffer The bytes to write
+ *    @param  write_len The number of bytes to write
+ *    @param  read_buffer Where to store the bytes read
+ *    @param  read_len The number of bytes to read
+ *    @param  stop Whether a stop ends the write, which makes no difference
+ *            to a replay
+ *    @return ms8607_status_t MS8607_OK on success
+ */
+ms8607_status_t Adafruit_MS8607_Replay::Port::write_then_read(
+    const uint8_t *write_buffer, size_t write_len, uint8_t *read_buffer,
+    size_t read_len, bool stop) {
+  (void)stop;
+  if (!_replay->_valid) {
+    return MS8607_ERR_NACK;
+  }
+  if (_is_pt) {
+    return _replay->_pt_transfer(write_buffer, write_len, read_buffer,
+                                 read_len);
+  }
+  return _replay->_hum_transfer(write_buffer, write_len, read_buffer,
+                                read_len);
+}
+
+/***************************  Private Methods *********************************/
+ms8607_status_t Adafruit_MS8607_Replay::_pt_transfer(
+    const uint8_t *write_buffer, size_t write_len, uint8_t *read_buffer,
+    size_t read_len) {
+  if (!write_buffer || write_len < 1) {
+    return MS8607_ERR_INVALID;
+  }
+  uint8_t cmd = write_buffer[0];
+
+  if (cmd == PSENSOR_RESET_COMMAND) {
+    return MS8607_OK;
+  }
+  if ((cmd & 0xE0) == PSENSOR_START_PRESSURE_ADC_CONVERSION &&
+      (cmd & 0x0F) <= 2 * MS8607_PRESSURE_RESOLUTION_OSR_8192) {
+    bool is_temp = cmd & 0x10;
+    // each record's D2 and D1 are replayed once, then the next is used
+    if (is_temp ? _temp_used : _pressure_used) {
+      const uint8_t *record = _next_pt(&_offset);
+      if (!record) {
+        return MS8607_ERR_NACK;
+      }
+      _pt_record = record;
+      _temp_used = false;
+      _pressure_used = false;
+      _hum_ready = record[0] == MS8607_CAPTURE_PT_HUMIDITY;
+    }
+    if (is_temp) {
+      _adc = get24(&_pt_record[5]);
+      _temp_used = true;
+    } else {
+      _adc = get24(&_pt_record[8]);
+      _pressure_used = true;
+    }
+    return MS8607_OK;
+  }
+  if (cmd == PSENSOR_READ_ADC && read_buffer && read_len == 3) {
+    read_buffer[0] = _adc >> 16;
+    read_buffer[1] = _adc >> 8;
+    read_buffer[2] = _adc;
+    _adc = 0;
+    return MS8607_OK;
+  }
+  if ((cmd & 0xF1) == PROM_ADDRESS_READ_ADDRESS_0 && read_buffer &&
+      read_len == 2) {
+    uint8_t index = (cmd >> 1) & 0x7;
+    uint16_t word = index < 7 ? _prom[index] : 0;
+    read_buffer[0] = word >> 8;
+    read_buffer[1] = word;
+    return MS8607_OK;
+  }
+  return MS8607_ERR_INVALID;
+}
+
+ms8607_status_t Adafruit_MS8607_Replay::_hum_transfer(
+    const uint8_t *write_buffer, size_t write_len, uint8_t *read_buffer,
+    size_t read_len) {
+  if (write_buffer) {
+    switch (write_buffer[0]) {
+    case HSENSOR_RESET_COMMAND:
+      _user_register = 0x02;
+      _hum_pending = false;
+      return MS8607_OK;
+    case HSENSOR_WRITE_USER_REG_COMMAND:
+      if (write_len != 2) {
+        return MS8607_ERR_INVALID;
+      }
+      _user_register = write_buffer[1];
+      return MS8607_OK;
+    case HSENSOR_READ_USER_REG_COMMAND:
+      if (!read_buffer || read_len != 1) {
+        return MS8607_ERR_INVALID;
+      }
+      read_buffer[0] = _user_register;
+      return MS8607_OK;
+    case HSENSOR_READ_HUMIDITY_WO_HOLD_COMMAND:
+    case HSENSOR_READ_HUMIDITY_W_HOLD_COMMAND: {
+      // the humidity read with the temperature & pressure being replayed,
+      // else the next record if it is a read of humidity alone
+      size_t offset = _offset;
+      const uint8_t *record = _next(&offset);
+
+      if (_hum_ready) {
+        _hum_time = get32(&_pt_record[11]);
+        _hum_raw = get16(&_pt_record[15]);
+        _hum_ready = false;
+      } else if (record && record[0] == MS8607_CAPTURE_HUMIDITY) {
+        _offset = offset;
+        _hum_time = get32(&record[1]);
+        _hum_raw = get16(&record[5]);
+      } else {
+        return MS8607_ERR_NACK;
+      }
+      _hum_pending = true;
+      if (!read_buffer) {
+        return MS8607_OK;
+      }
+      break;
+    }
+    default:
+      return MS8607_ERR_INVALID;
+    }
+  }
+
+  // the result is ready at once, as replayed conversions take no time
+  if (!_hum_pending) {
+    return MS8607_ERR_NACK;
+  }
+  if (read_len != 3) {
+    return MS8607_ERR_INVALID;
+  }
+  _hum_pending = false;
+  read_buffer[0] = _hum_raw >> 8;
+  read_buffer[1] = _hum_raw;
+  read_buffer[2] = ms8607_humidity_crc(read_buffer, 2);
+  return MS8607_OK;
+}
+
+const uint8_t *Adafruit_MS8607_Replay::_next(size_t *offset) {
+  if (*offset < _len) {
+    const uint8_t *record = &_capture[*offset];
+    size_t len;
+
+    switch (record[0]) {
+    case MS8607_CAPTURE_PT:
+      len = MS8607_CAPTURE_PT_LEN;
+      break;
+    case MS8607_CAPTURE_HUMIDITY:
+      len = MS8607_CAPTURE_HUMIDITY_LEN;
+      break;
+    case MS8607_CAPTURE_PT_HUMIDITY:
+      len = MS8607_CAPTURE_PT_HUMIDITY_LEN;
+      break;
+    default:
+      // unknown record, the rest of the capture cannot be read
+      len = 0;
+      break;
+    }
+    if (len && *offset + len <= _len) {
+      *offset += len;
+      return record;
+    }
+  }
+  *offset = _len;
+  return NULL;
+}
+
+const uint8_t *Adafruit_MS8607_Replay::_next_pt(size_t *offset) {
+  const uint8_t *record;
+
+  // reads of humidity alone that were not repeated are passed over
+  do {
+    record = _next(offset);
+  } while (record && record[0] == MS8607_CAPTURE_HUMIDITY);
+  return record;
+}
@@ -0,0 +1,90 @@
+/*!
+ *  @file Adafruit_MS8607_Replay.h
+ *
+ *  Replay of a capture of raw MS8607 readings. It answers the driver's
+ *  commands like the sensor did when the capture was made: PROM reads
+ *  return the captured calibration and each read's conversions return the
+ *  values captured by the same read. With Adafruit_MS8607_VirtualClock as
+ *  the driver's clock conversion waits take no time, so replays are fast
+ *  and repeatable.
+ *
+ *  MIT license, all text above must be included in any redistribution
+ */
+
+#ifndef __MS8607_REPLAY_H__
+#define __MS8607_REPLAY_H__
+
+#include <Adafruit_MS8607_Capture.h>
+#include <Adafruit_MS8607_Transport.h>
+
+/**
+ * @brief Replayed MS8607 providing a transport for each of its two dies
+ *
+ */
+class Adafruit_MS8607_Replay {
+public:
+  Adafruit_MS8607_Replay(const uint8_t *capture, size_t len);
+
+  Adafruit_MS8607_Transport *getPTTransport(void);
+  Adafruit_MS8607_Transport *getHumidityTransport(void);
+
+  bool isValid(void);
+  bool atEnd(void);
+  bool hasHumidity(void);
+  void rewind(void);
+  uint32_t getPTTime(void);
+  uint32_t getHumidityTime(void);
+
+private:
+  // not copyable, the ports point back to the replay
+  Adafruit_MS8607_Replay(const Adafruit_MS8607_Replay &);
+  Adafruit_MS8607_Replay &operator=(const Adafruit_MS8607_Replay &);
+
+  /** Transport for one of the replayed dies */
+  class Port final : public Adafruit_MS8607_Transport {
+  public:
+    /** @brief Create a port
+        @param replay The replay
+        @param is_pt true for the pressure & temperature die */
+    Port(Adafruit_MS8607_Replay *replay, bool is_pt)
+        : _replay(replay), _is_pt(is_pt) {}
+    ms8607_status_t begin(void);
+    ms8607_status_t write(const uint8_t *buffer, size_t len);
+    ms8607_status_t read(uint8_t *buffer, size_t len);
+    ms8607_status_t write_then_read(const uint8_t *write_buffer,
+                                    size_t write_len, uint8_t *read_buffer,
+                                    size_t read_len, bool stop = false);
+
+  private:
+    Adafruit_MS8607_Replay *_replay; ///< The replay
+    bool _is_pt; ///< true for the pressure & temperature die
+  };
+
+  ms8607_status_t _pt_transfer(const uint8_t *write_buffer, size_t write_len,
+                               uint8_t *read_buffer, size_t read_len);
+  ms8607_status_t _hum_transfer(const uint8_t *write_buffer,
+                                size_t write_len, uint8_t *read_buffer,
+                                size_t read_len);
+  const uint8_t *_next(size_t *offset);
+  const uint8_t *_next_pt(size_t *offset);
+
+  Port _pt;  ///< Pressure & temperature die
+  Port _hum; ///< Humidity die
+
+  const uint8_t *_capture;          ///< The capture being replayed
+  size_t _len;                      ///< Length of the capture in bytes
+  bool _valid;                      ///< Whether the header is good
+  uint16_t _prom[7];                ///< PROM words from the header
+  size_t _offset;                   ///< Next record to replay
+  const uint8_t *_pt_record = NULL; ///< Temperature record being replayed
+  bool _temp_used = true;           ///< D2 of _pt_record has been converted
+  bool _pressure_used = true;       ///< D1 of _pt_record has been converted
+  bool _hum_ready = false;          ///< _pt_record humidity not yet converted
+  uint32_t _adc = 0;                ///< Result of the last PT conversion
+  bool _hum_pending = false;        ///< A humidity result is ready to read
+  uint32_t _hum_time = 0;           ///< When the replayed humidity was read
+  uint16_t _hum_raw = 0;            ///< Raw humidity being replayed
+  uint8_t _user_register = 0x02;    ///< Humidity user register
+};
+
+#endif
@@ -0,0 +1,306 @@
+/*!
+ *  @file Adafruit_MS8607_Scheduler.cpp
+ *
+ *  Fixed-cadence acquisition scheduler for the MS8607
+ *
+ *  MIT license, all text above must be included in any redistribution
+ */
+
+#include <Adafruit_MS8607_Scheduler.h>
+
+#ifndef MS8607_NO_FLOAT
+
+/*!
+ *    @brief  Instantiates a new scheduler for a sensor
+ *    @param  sensor The sensor to sample. begin() must have been called on it
+ *            before the scheduler is started
+ */
+Adafruit_MS8607_Scheduler::Adafruit_MS8607_Scheduler(Adafruit_MS8607 *sensor) {
+  _sensor = sensor;
+}
+
+/**
+ * @brief Start sampling at a fixed period. The first sample is taken at
+ * `now_us`
+ *
+ * @param period_us The sample period in microseconds. Must be longer than the
+ * time needed for all conversions of one sample
+ * @param now_us The current time in microseconds
+ * @param read_humidity true: measure humidity in each sample as well as
+ * pressure and temperature
+ * @return true: success false: the period is too short for the conversions
+ */
+bool Adafruit_MS8607_Scheduler::start(uint32_t period_us, uint32_t now_us,
+                                      bool read_humidity) {
+  uint32_t needed_us = 2 * _sensor->getPTConversionTime();
+  if (read_humidity) {
+    needed_us += _sensor->getHumidityConversionTime();
+  }
+  if (period_us <= needed_us) {
+    return false;
+  }
+
+  _state = MS8607_SCHED_IDLE;
+  _read_humidity = read_humidity;
+  _period_us = period_us;
+  _next_slot_us = now_us;
+  _missed = 0;
+  _overruns = 0;
+  _errors = 0;
+  _state = MS8607_SCHED_WAIT_SLOT;
+  return true;
+}
+
+/**
+ * @brief Stop sampling. Samples already in the queue can still be read
+ *
+ */
+void Adafruit_MS8607_Scheduler::stop(void) { _state = MS8607_SCHED_IDLE; }
+
+/**
+ * @brief Advance the acquisition sequence. Issues at most one conversion
+ * command and one ADC read per call and never waits
+ *
+ * @param now_us The current time in microseconds
+ */
+void Adafruit_MS8607_Scheduler::tick(uint32_t now_us) {
+  uint32_t start_us;
+
+  switch (_state) {
+  case MS8607_SCHED_IDLE:
+    return;
+
+  case MS8607_SCHED_WAIT_SLOT: {
+    if (!_due(now_us, _next_slot_us)) {
+      return;
+    }
+    // skip any slots that passed entirely while we were not called
+    uint32_t late_us = now_us - _next_slot_us;
+    if (late_us >= _period_us) {
+      uint32_t skipped = late_us / _period_us;
+      _missed += skipped;
+      _next_slot_us += skipped * _period_us;
+    }
+    _slot_us = _next_slot_us;
+    _next_slot_us += _period_us;
+
+    start_us = _sensor->getClock()->micros();
+    if (!_sensor->startTemperatureConversion()) {
+      _abort();
+      return;
+    }
+    _deadline_us = _deadline(now_us, start_us, _sensor->getPTConversionTime());
+    _state = MS8607_SCHED_WAIT_TEMPERATURE;
+    return;
+  }
+
+  case MS8607_SCHED_WAIT_TEMPERATURE:
+    if (!_due(now_us, _deadline_us)) {
+      return;
+    }
+    start_us = _sensor->getClock()->micros();
+    if (!_sensor->readPTConversion(&_raw_temp) ||
+        !_sensor->startPressureConversion()) {
+      _abort();
+      return;
+    }
+    _deadline_us = _deadline(now_us, start_us, _sensor->getPTConversionTime());
+    _state = MS8607_SCHED_WAIT_PRESSURE;
+    return;
+
+  case MS8607_SCHED_WAIT_PRESSURE:
+    if (!_due(now_us, _deadline_us)) {
+      return;
+    }
+    start_us = _sensor->getClock()->micros();
+    if (!_sensor->readPTConversion(&_raw_pressure)) {
+      _abort();
+      return;
+    }
+    if (!_read_humidity) {
+      _finish(now_us);
+      return;
+    }
+    if (!_sensor->startHumidityConversion()) {
+      _abort();
+      return;
+    }
+    _deadline_us =
+        _deadline(now_us, start_us, _sensor->getHumidityConversionTime());
+    _state = MS8607_SCHED_WAIT_HUMIDITY;
+    return;
+
+  case MS8607_SCHED_WAIT_HUMIDITY:
+    if (!_due(now_us, _deadline_us)) {
+      return;
+    }
+    if (!_sensor->readHumidityConversion(&_raw_humidity)) {
+      _abort();
+      return;
+    }
+    _finish(now_us);
+    return;
+  }
+}
+
+/**
+ * @brief Get the number of samples waiting to be read
+ *
+ * @return uint8_t the number of queued samples
+ */
+uint8_t Adafruit_MS8607_Scheduler::available(void) {
+  return (uint8_t)(_head - _tail);
+}
+
+/**
+ * @brief Take the oldest sample from the queue
+ *
+ * @param sample The sample to fill
+ * @return true: a sample was read false: the queue is empty
+ */
+bool Adafruit_MS8607_Scheduler::read(ms8607_sample_t *sample) {
+  if (!available()) {
+    return false;
+  }
+  *sample = _queue[_tail & (MS8607_SCHEDULER_QUEUE_LEN - 1)];
+  _tail = _tail + 1;
+  return true;
+}
+
+#ifndef MS8607_NO_UNIFIED_SENSOR
+/**
+ * @brief Take up to `max_samples` of the oldest samples from the queue as
+ * Unified Sensor events, in one pass. Each event array, if not NULL, must
+ * have room for `max_samples` events and gets one event per sample, oldest
+ * first. Like getEvent()'s, each event is timestamped with the midpoint of
+ * its own conversion moved to the millis() timebase, which needs tick()'s
+ * time to be the sensor clock's micros(). Humidity events hold 0, stamped
+ * with the scheduled time, if humidity is not being measured
+ *
+ * @param temp Where to store temperature events, or NULL
+ * @param pressure Where to store pressure events, or NULL
+ * @param humidity Where to store humidity events, or NULL
+ * @param max_samples The most samples to take
+ * @return uint8_t the number of samples taken
+ */
+uint8_t Adafruit_MS8607_Scheduler::readEvents(sensors_event_t *temp,
+                                              sensors_event_t *pressure,
+                                              sensors_event_t *humidity,
+                                              uint8_t max_samples) {
+  sensors_event_t temp_header, pressure_header, humidity_header;
+  uint8_t count = available();
+
+  if (count > max_samples) {
+    count = max_samples;
+  }
+  if (!count) {
+    return 0;
+  }
+  // the fields every event shares are filled in once and copied, rather
+  // than clearing and filling each event separately
+  _sensor->fillTempEvent(&temp_header, 0);
+  _sensor->fillPressureEvent(&pressure_header, 0);
+  _sensor->fillHumidityEvent(&humidity_header, 0);
+
+  for (uint8_t i = 0; i < count; i++) {
+    const ms8607_sample_t *sample =
+        &_queue[(uint8_t)(_tail + i) & (MS8607_SCHEDULER_QUEUE_LEN - 1)];
+
+    if (temp) {
+      temp[i] = temp_header;
+      temp[i].timestamp = _sensor->_to_millis(sample->temperature_us);
+      temp[i].temperature = sample->temperature;
+    }
+    if (pressure) {
+      pressure[i] = pressure_header;
+      pressure[i].timestamp = _sensor->_to_millis(sample->pressure_us);
+      pressure[i].pressure = sample->pressure;
+    }
+    if (humidity) {
+      humidity[i] = humidity_header;
+      humidity[i].timestamp = _sensor->_to_millis(sample->humidity_us);
+      humidity[i].relative_humidity = sample->humidity;
+    }
+  }
+  _tail = _tail + count;
+  return count;
+}
+#endif
+
+/**
+ * @brief Get the number of sample slots that were skipped, or whose sample
+ * completed after the following slot had already begun
+ *
+ * @return uint32_t the number of missed deadlines since start()
+ */
+uint32_t Adafruit_MS8607_Scheduler::missedDeadlines(void) { return _missed; }
+
+/**
+ * @brief Get the number of samples dropped because the queue was full
+ *
+ * @return uint32_t the number of dropped samples since start()
+ */
+uint32_t Adafruit_MS8607_Scheduler::overruns(void) { return _overruns; }
+
+/**
+ * @brief Get the number of samples abandoned because of a bus error
+ *
+ * @return uint32_t the number of failed samples since start()
+ */
+uint32_t Adafruit_MS8607_Scheduler::errors(void) { return _errors; }
+
+/***************************  Private Methods *********************************/
+bool Adafruit_MS8607_Scheduler::_due(uint32_t now_us, uint32_t deadline_us) {
+  // signed difference keeps working across micros() rollover
+  return (int32_t)(now_us - deadline_us) >= 0;
+}
+
+uint32_t Adafruit_MS8607_Scheduler::_deadline(uint32_t now_us,
+                                              uint32_t start_us,
+                                              uint32_t conversion_us) {
+  // the conversion starts when its command has been sent, so the bus time
+  // since start_us, measured on the sensor's clock, is added to now_us
+  return now_us + (_sensor->getClock()->micros() - start_us) + conversion_us;
+}
+
+void Adafruit_MS8607_Scheduler::_abort(void) {
+  _errors++;
+  _state = MS8607_SCHED_WAIT_SLOT;
+}
+
+void Adafruit_MS8607_Scheduler::_finish(uint32_t now_us) {
+  _state = MS8607_SCHED_WAIT_SLOT;
+  if ((int32_t)(now_us - _next_slot_us) > 0) {
+    _missed++;
+  }
+  // humidity is computed after temperature & pressure, as in read(), so a
+  // capture records the sample in one record
+  bool ok = _sensor->computePressureTemperature(_raw_temp, _raw_pressure);
+  if (ok && _read_humidity) {
+    _sensor->computeHumidity(_raw_humidity);
+  }
+#ifdef MS8607_ENABLE_CAPTURE
+  _sensor->_capture_flush();
+#endif
+  if (!ok) {
+    _errors++;
+    return;
+  }
+  if (available() >= MS8607_SCHEDULER_QUEUE_LEN) {
+    _overruns++;
+    return;
+  }
+
+  ms8607_sample_t *sample = &_queue[_head & (MS8607_SCHEDULER_QUEUE_LEN - 1)];
+  sample->timestamp_us = _slot_us;
+  sample->temperature_us = _sensor->getTemperatureMicros();
+  sample->pressure_us = _sensor->getPressureMicros();
+  sample->humidity_us =
+      _read_humidity ? _sensor->getHumidityMicros() : _slot_us;
+  sample->temperature = _sensor->getTemperature();
+  sample->pressure = _sensor->getPressure();
+  sample->humidity = _read_humidity ? _sensor->getHumidity() : 0;
+  _head = _head + 1;
+}
+
+#endif // MS8607_NO_FLOAT
@@ -0,0 +1,102 @@
+/*!
+ *  @file Adafruit_MS8607_Scheduler.h
+ *
+ *  Fixed-cadence acquisition scheduler for the MS8607. Conversions and ADC
+ *  reads are sequenced from a periodic tick() so that no call ever blocks
+ *  waiting for a conversion. Samples are floats, so the scheduler is not
+ *  available with MS8607_NO_FLOAT.
+ *
+ *  MIT license, all text above must be included in any redistribution
+ */
+
+#ifndef __MS8607_SCHEDULER_H__
+#define __MS8607_SCHEDULER_H__
+
+#include <Adafruit_MS8607.h>
+
+#ifndef MS8607_NO_FLOAT
+
+#define MS8607_SCHEDULER_QUEUE_LEN                                             \
+  8 ///< Number of samples buffered by the scheduler, must be a power of 2
+
+/**
+ * @brief A single scheduled measurement
+ *
+ */
+typedef struct {
+  uint32_t timestamp_us;   ///< The scheduled sample time in microseconds
+  uint32_t temperature_us; ///< Midpoint of the temperature conversion
+  uint32_t pressure_us;    ///< Midpoint of the pressure conversion
+  uint32_t humidity_us;    ///< Humidity conversion midpoint, if measured
+  float temperature;       ///< Temperature in degrees C
+  float pressure;          ///< Pressure in hPa
+  float humidity;          ///< Relative humidity in %rH
+} ms8607_sample_t;
+
+/**
+ * @brief Sequences MS8607 conversions from a periodic tick to produce samples
+ * at a fixed cadence.
+ *
+ * tick() should be called with the current time at a rate well above the
+ * sample rate, either from loop() or a timer callback on platforms where I2C
+ * may be used from that context. Time is passed in rather than read so the
+ * scheduler can be driven by a simulated clock.
+ */
+class Adafruit_MS8607_Scheduler {
+public:
+  Adafruit_MS8607_Scheduler(Adafruit_MS8607 *sensor);
+
+  bool start(uint32_t period_us, uint32_t now_us, bool read_humidity = true);
+  void stop(void);
+  void tick(uint32_t now_us);
+
+  uint8_t available(void);
+  bool read(ms8607_sample_t *sample);
+#ifndef MS8607_NO_UNIFIED_SENSOR
+  uint8_t readEvents(sensors_event_t *temp, sensors_event_t *pressure,
+                     sensors_event_t *humidity, uint8_t max_samples);
+#endif
+
+  uint32_t missedDeadlines(void);
+  uint32_t overruns(void);
+  uint32_t errors(void);
+
+private:
+  /** States of the acquisition sequence */
+  typedef enum {
+    MS8607_SCHED_IDLE,
+    MS8607_SCHED_WAIT_SLOT,
+    MS8607_SCHED_WAIT_TEMPERATURE,
+    MS8607_SCHED_WAIT_PRESSURE,
+    MS8607_SCHED_WAIT_HUMIDITY,
+  } ms8607_sched_state_t;
+
+  bool _due(uint32_t now_us, uint32_t deadline_us);
+  uint32_t _deadline(uint32_t now_us, uint32_t start_us,
+                     uint32_t conversion_us);
+  void _abort(void);
+  void _finish(uint32_t now_us);
+
+  Adafruit_MS8607 *_sensor; ///< The sensor being sampled
+  volatile ms8607_sched_state_t _state = MS8607_SCHED_IDLE; ///< Sequence state
+  bool _read_humidity = true; ///< Whether humidity is part of each sample
+  uint32_t _period_us = 0;    ///< The sample period
+  uint32_t _slot_us = 0;      ///< Start time of the sample in progress
+  uint32_t _next_slot_us = 0; ///< Start time of the next sample
+  uint32_t _deadline_us = 0;  ///< When the current conversion completes
+  uint32_t _raw_temp = 0;     ///< Raw temperature of the sample in progress
+  uint32_t _raw_pressure = 0; ///< Raw pressure of the sample in progress
+  uint16_t _raw_humidity = 0; ///< Raw humidity of the sample in progress
+
+  ms8607_sample_t _queue[MS8607_SCHEDULER_QUEUE_LEN]; ///< Completed samples
+  volatile uint8_t _head = 0; ///< Queue write index, only changed by tick()
+  volatile uint8_t _tail = 0; ///< Queue read index, only changed by read()
+
+  uint32_t _missed = 0;   ///< Count of missed sample deadlines
+  uint32_t _overruns = 0; ///< Samples dropped due to a full queue
+  uint32_t _errors = 0;   ///< Samples aborted due to bus errors
+};
+
+#endif // MS8607_NO_FLOAT
+
+#endif
@@ -0,0 +1,382 @@
+/*!
+ *  @file Adafruit_MS8607_Simulator.cpp
+ *
+ *  A simulated MS8607 on a simulated I2C bus
+ *
+ *  MIT license, all text above must be included in any redistribution
+ */
+
+#include <Adafruit_MS8607.h>
+#include <Adafruit_MS8607_Simulator.h>
+
+// example calibration and readings from the datasheet, giving 20.00 C and
+// 1100.02 hPa
+static const uint16_t default_calibration[6] = {46372, 43981, 29059,
+                                                27842, 31553, 28165};
+static const uint32_t pt_conversion_times[6] = {
+    PSENSOR_CONVERSION_TIME_OSR_256,  PSENSOR_CONVERSION_TIME_OSR_512,
+    PSENSOR_CONVERSION_TIME_OSR_1024, PSENSOR_CONVERSION_TIME_OSR_2048,
+    PSENSOR_CONVERSION_TIME_OSR_4096, PSENSOR_CONVERSION_TIME_OSR_8192};
+
+/*!
+ *    @brief  Instantiates a simulated sensor
+ *    @param  clock The virtual clock that conversions are timed against and
+ *            that bus time is charged to. It should also be the clock of the
+ *            driver under test
+ */
+Adafruit_MS8607_Simulator::Adafruit_MS8607_Simulator(
+    Adafruit_MS8607_VirtualClock *clock)
+    : _pt(this, true), _hum(this, false) {
+  _clock = clock;
+  setCalibration(default_calibration);
+  setRawValues(6465444, 8077636, 0x6A50);
+  setSerialNumber(MS8607_SIM_SERIAL);
+  setBusSpeed(MS8607_SIM_BUS_HZ);
+}
+
+/**
+ * @brief Get the transport for the pressure & temperature die
+ *
+ * @return Adafruit_MS8607_Transport* the transport to pass to begin()
+ */
+Adafruit_MS8607_Transport *Adafruit_MS8607_Simulator::getPTTransport(void) {
+  return &_pt;
+}
+
+/**
+ * @brief Get the transport for the humidity die
+ *
+ * @return Adafruit_MS8607_Transport* the transport to pass to begin()
+ */
+Adafruit_MS8607_Transport *
+Adafruit_MS8607_Simulator::getHumidityTransport(void) {
+  return &_hum;
+}
+
+/**
+ * @brief Set the calibration coefficients in PROM. The CRC is filled in
+ *
+ * @param coefficients The six coefficients C1 to C6
+ */
+void Adafruit_MS8607_Simulator::setCalibration(const uint16_t *coefficients) {
+  _prom[0] = 0;
+  for (uint8_t i = 0; i < 6; i++) {
+    _prom[i + 1] = coefficients[i];
+  }
+  _prom[7] = 0;
+  _prom[0] = (uint16_t)ms8607_prom_crc(_prom) << 12;
+}
+
+/**
+ * @brief Set the values returned by conversions
+ *
+ * @param raw_pressure The raw pressure (D1) value
+ * @param raw_temp The raw temperature (D2) value
+ * @param raw_humidity The raw humidity value
+ */
+void Adafruit_MS8607_Simulator::setRawValues(uint32_t raw_pressure,
+                                             uint32_t raw_temp,
+                                             uint16_t raw_humidity) {
+  _raw_pressure = raw_pressure;
+  _raw_temp = raw_temp;
+  _raw_humidity = raw_humidity;
+}
+
+/**
+ * @brief Set the serial number the humidity die reports
+ *
+ * @param serial The 64-bit serial number, SNA_1 in the top byte down to
+ * SNC_0 in the bottom one
+ */
+void Adafruit_MS8607_Simulator::setSerialNumber(uint64_t serial) {
+  _serial = serial;
+}
+
+/**
+ * @brief Set the simulated bus clock, which sets how much time each byte
+ * takes
+ *
+ * @param hz The bus clock in Hz, at least 1 kHz
+ */
+void Adafruit_MS8607_Simulator::setBusSpeed(uint32_t hz) {
+  // 8 data bits and an ACK per byte
+  _byte_ns = 9000000UL / (hz / 1000);
+}
+
+/**
+ * @brief Make upcoming transactions fail
+ *
+ * @param status The status the failing transactions return
+ * @param count The number of transactions to fail
+ * @param skip The number of transactions to let through first
+ */
+void Adafruit_MS8607_Simulator::injectFault(ms8607_status_t status,
+                                            uint16_t count, uint16_t skip) {
+  _fault_status = status;
+  _faults = count;
+  _fault_skip = skip;
+}
+
+/**
+ * @brief Get the number of transactions on either die
+ *
+ * @return uint32_t the transactions since the last resetCounters()
+ */
+uint32_t Adafruit_MS8607_Simulator::getTransactions(void) {
+  return _transactions;
+}
+
+/**
+ * @brief Get the time the bus was busy, including clock stretching
+ *
+ * @return uint32_t the bus time in microseconds since the last
+ * resetCounters()
+ */
+uint32_t Adafruit_MS8607_Simulator::getBusMicros(void) { return _bus_us; }
+
+/**
+ * @brief Clear the transaction count and bus time
+ *
+ */
+void Adafruit_MS8607_Simulator::resetCounters(void) {
+  _transactions = 0;
+  _bus_us = 0;
+}
+
+/*!
+ *    @brief  The simulated device always acknowledges its address
+ *    @return ms8607_status_t MS8607_OK on success
+ */
+ms8607_status_t Adafruit_MS8607_Simulator::Port::begin(void) {
+  return _sim->_transfer(_is_pt, NULL, 0, NULL, 0);
+}
+
+/*!
+ *    @brief  Write to the simulated die
+ *    @param  buffer The bytes to write
+ *    @param  len The number of bytes to write
+ *    @return ms8607_status_t MS8607_OK on success
+ */
+ms8607_status_t Adafruit_MS8607_Simulator::Port::write(const uint8_t *buffer,
+                                                       size_t len) {
+  return _sim->_transfer(_is_pt, buffer, len, NULL, 0);
+}
+
+/*!
+ *    @brief  Read from the simulated die
+ *    @param  buffer Where to store the bytes read
+ *    @param  len The number of bytes to read
+ *    @return ms8607_status_t MS8607_OK on success
+ */
+ms8607_status_t Adafruit_MS8607_Simulator::Port::read(uint8_t *buffer,
+                                                      size_t len) {
+  return _sim->_transfer(_is_pt, NULL, 0, buffer, len);
+}
+
+/*!
+ *    @brief  Write to the simulated die then read from it
+ *    @param  write_buffer The bytes to write
+ *    @param  write_len The number of bytes to write
+ *    @param  read_buffer Where to store the bytes read
+ *    @param  read_len The number of bytes to read
+ *    @param  stop Whether a stop ends the write, which the simulated die
+ *            answers the same either way
+ *    @return ms8607_status_t MS8607_OK on success
+ */
+ms8607_status_t Adafruit_MS8607_Simulator::Port::write_then_read(
+    const uint8_t *write_buffer, size_t write_len, uint8_t *read_buffer,
+    size_t read_len, bool stop) {
+  (void)stop;
+  return _sim->_transfer(_is_pt, write_buffer, write_len, read_buffer,
+                         read_len);
+}
+
+/***************************  Private Methods *********************************/
+ms8607_status_t Adafruit_MS8607_Simulator::_transfer(
+    bool is_pt, const uint8_t *write_buffer, size_t write_len,
+    uint8_t *read_buffer, size_t read_len) {
+  _transactions++;
+  if (_fault_skip) {
+    _fault_skip--;
+  } else if (_faults) {
+    _faults--;
+    _charge(1);
+    return _fault_status;
+  }
+  if (!write_buffer && !read_buffer) {
+    // address probe
+    _charge(1);
+    return MS8607_OK;
+  }
+  // address byte for each direction, plus the data
+  size_t bytes = write_buffer ? 1 + write_len : 0;
+  bytes += read_buffer ? 1 + read_len : 0;
+  _charge(bytes);
+  if (is_pt) {
+    return _pt_transfer(write_buffer, write_len, read_buffer, read_len);
+  }
+  return _hum_transfer(write_buffer, write_len, read_buffer, read_len);
+}
+
+ms8607_status_t Adafruit_MS8607_Simulator::_pt_transfer(
+    const uint8_t *write_buffer, size_t write_len, uint8_t *read_buffer,
+    size_t read_len) {
+  if (!write_buffer || write_len < 1) {
+    return MS8607_ERR_INVALID;
+  }
+  uint8_t cmd = write_buffer[0];
+
+  if (cmd == PSENSOR_RESET_COMMAND) {
+    _pt_pending = 0;
+    return MS8607_OK;
+  }
+  if ((cmd & 0xE0) == PSENSOR_START_PRESSURE_ADC_CONVERSION &&
+      (cmd & 0x0F) <= 2 * MS8607_PRESSURE_RESOLUTION_OSR_8192) {
+    _pt_pending = cmd;
+    _pt_done_us = _clock->micros() + pt_conversion_times[(cmd & 0x0F) / 2];
+    return MS8607_OK;
+  }
+  if (cmd == PSENSOR_READ_ADC && read_buffer && read_len == 3) {
+    // reading before the conversion ends, or without one, returns 0
+    uint32_t adc = 0;
+    if (_pt_pending && _done(_pt_done_us)) {
+      adc = (_pt_pending & 0x10) ? _raw_temp : _raw_pressure;
+    }
+    _pt_pending = 0;
+    read_buffer[0] = adc >> 16;
+    read_buffer[1] = adc >> 8;
+    read_buffer[2] = adc;
+    return MS8607_OK;
+  }
+  if ((cmd & 0xF1) == PROM_ADDRESS_READ_ADDRESS_0 && read_buffer &&
+      read_len == 2) {
+    uint16_t word = _prom[(cmd >> 1) & 0x7];
+    read_buffer[0] = word >> 8;
+    read_buffer[1] = word;
+    return MS8607_OK;
+  }
+  return MS8607_ERR_INVALID;
+}
+
+ms8607_status_t Adafruit_MS8607_Simulator::_hum_transfer(
+    const uint8_t *write_buffer, size_t write_len, uint8_t *read_buffer,
+    size_t read_len) {
+  uint32_t stretch_us;
+  // a read of the user register may come after a stop, as its own read
+  bool register_selected = _user_register_selected;
+
+  _user_register_selected = false;
+  if (write_buffer) {
+    switch (write_buffer[0]) {
+    case HSENSOR_RESET_COMMAND:
+      _user_register = 0x02;
+      _hum_pending = false;
+      return MS8607_OK;
+    case HSENSOR_WRITE_USER_REG_COMMAND:
+      if (write_len != 2) {
+        return MS8607_ERR_INVALID;
+      }
+      _user_register = write_buffer[1];
+      return MS8607_OK;
+    case HSENSOR_READ_USER_REG_COMMAND:
+      if (!read_buffer) {
+        _user_register_selected = write_len == 1;
+        return write_len == 1 ? MS8607_OK : MS8607_ERR_INVALID;
+      }
+      if (read_len != 1) {
+        return MS8607_ERR_INVALID;
+      }
+      read_buffer[0] = _user_register;
+      return MS8607_OK;
+    case HSENSOR_READ_SERIAL_FIRST_8BYTES_COMMAND >> 8:
+      if (write_len != 2 ||
+          write_buffer[1] !=
+              (HSENSOR_READ_SERIAL_FIRST_8BYTES_COMMAND & 0xFF) ||
+          !read_buffer || read_len != 8) {
+        return MS8607_ERR_INVALID;
+      }
+      // SNB_3 to SNB_0, each followed by its CRC
+      for (uint8_t i = 0; i < 4; i++) {
+        read_buffer[2 * i] = _serial >> (40 - 8 * i);
+        read_buffer[2 * i + 1] = ms8607_humidity_crc(&read_buffer[2 * i], 1);
+      }
+      return MS8607_OK;
+    case HSENSOR_READ_SERIAL_LAST_6BYTES_COMMAND >> 8:
+      if (write_len != 2 ||
+          write_buffer[1] != (HSENSOR_READ_SERIAL_LAST_6BYTES_COMMAND & 0xFF) ||
+          !read_buffer || read_len != 6) {
+        return MS8607_ERR_INVALID;
+      }
+      // SNC_1, SNC_0 and their CRC, then SNA_1, SNA_0 and theirs
+      read_buffer[0] = _serial >> 8;
+      read_buffer[1] = _serial;
+      read_buffer[2] = ms8607_humidity_crc(&read_buffer[0], 2);
+      read_buffer[3] = _serial >> 56;
+      read_buffer[4] = _serial >> 48;
+      read_buffer[5] = ms8607_humidity_crc(&read_buffer[3], 2);
+      return MS8607_OK;
+    case HSENSOR_READ_HUMIDITY_WO_HOLD_COMMAND:
+    case HSENSOR_READ_HUMIDITY_W_HOLD_COMMAND:
+      _hum_pending = true;
+      _hum_done_us = _clock->micros() + _hum_conversion_time();
+      if (write_buffer[0] == HSENSOR_READ_HUMIDITY_WO_HOLD_COMMAND) {
+        return read_buffer ? MS8607_ERR_NACK : MS8607_OK;
+      }
+      if (!read_buffer) {
+        return MS8607_OK;
+      }
+      // hold master: SCL is stretched until the conversion ends
+      stretch_us = _hum_done_us - _clock->micros();
+      _clock->advance(stretch_us);
+      _bus_us += stretch_us;
+      break;
+    default:
+      return MS8607_ERR_INVALID;
+    }
+  }
+
+  if (register_selected && !write_buffer) {
+    if (read_len != 1) {
+      return MS8607_ERR_INVALID;
+    }
+    read_buffer[0] = _user_register;
+    return MS8607_OK;
+  }
+  // the humidity die NACKs its read address while converting
+  if (!_hum_pending || !_done(_hum_done_us)) {
+    return MS8607_ERR_NACK;
+  }
+  if (read_len != 3) {
+    return MS8607_ERR_INVALID;
+  }
+  _hum_pending = false;
+  read_buffer[0] = _raw_humidity >> 8;
+  read_buffer[1] = _raw_humidity;
+  read_buffer[2] = ms8607_humidity_crc(read_buffer, 2);
+  return MS8607_OK;
+}
+
+void Adafruit_MS8607_Simulator::_charge(size_t bytes) {
+  _fraction_ns += bytes * _byte_ns;
+  uint32_t us = _fraction_ns / 1000;
+  _fraction_ns %= 1000;
+  _clock->advance(us);
+  _bus_us += us;
+}
+
+bool Adafruit_MS8607_Simulator::_done(uint32_t deadline_us) {
+  return (int32_t)(_clock->micros() - deadline_us) >= 0;
+}
+
+uint32_t Adafruit_MS8607_Simulator::_hum_conversion_time(void) {
+  switch (_user_register & HSENSOR_USER_REG_RESOLUTION_MASK) {
+  case MS8607_HUMIDITY_RESOLUTION_OSR_8b:
+    return HSENSOR_CONVERSION_TIME_8b * 1000UL;
+  case MS8607_HUMIDITY_RESOLUTION_OSR_10b:
+    return HSENSOR_CONVERSION_TIME_10b * 1000UL;
+  case MS8607_HUMIDITY_RESOLUTION_OSR_11b:
+    return HSENSOR_CONVERSION_TIME_11b * 1000UL;
+  default:
+    return HSENSOR_CONVERSION_TIME_12b * 1000UL;
+  }
+}
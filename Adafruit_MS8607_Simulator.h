@@ -0,0 +1,107 @@
+/*!
+ *  @file Adafruit_MS8607_Simulator.h
+ *
+ *  A simulated MS8607 on a simulated I2C bus. It answers the same commands
+ *  as the real sensor, models conversion times, clock stretching and
+ *  NACKs while converting, and charges bus time for every byte to a
+ *  virtual clock, so the driver can be exercised and benchmarked without
+ *  hardware. Faults can be injected to test error handling.
+ *
+ *  MIT license, all text above must be included in any redistribution
+ */
+
+#ifndef __MS8607_SIMULATOR_H__
+#define __MS8607_SIMULATOR_H__
+
+#include <Adafruit_MS8607_Clock.h>
+#include <Adafruit_MS8607_Transport.h>
+
+#define MS8607_SIM_BUS_HZ 400000 ///< Default simulated bus speed
+#define MS8607_SIM_SERIAL                                                      \
+  0x48540000C0DE3215ULL ///< Default simulated serial number
+
+/**
+ * @brief Simulated MS8607 providing a transport for each of its two dies
+ *
+ */
+class Adafruit_MS8607_Simulator {
+public:
+  Adafruit_MS8607_Simulator(Adafruit_MS8607_VirtualClock *clock);
+
+  Adafruit_MS8607_Transport *getPTTransport(void);
+  Adafruit_MS8607_Transport *getHumidityTransport(void);
+
+  void setCalibration(const uint16_t *coefficients);
+  void setRawValues(uint32_t raw_pressure, uint32_t raw_temp,
+                    uint16_t raw_humidity);
+  void setSerialNumber(uint64_t serial);
+  void setBusSpeed(uint32_t hz);
+  void injectFault(ms8607_status_t status, uint16_t count = 1,
+                   uint16_t skip = 0);
+
+  uint32_t getTransactions(void);
+  uint32_t getBusMicros(void);
+  void resetCounters(void);
+
+private:
+  // not copyable, the ports point back to the simulator
+  Adafruit_MS8607_Simulator(const Adafruit_MS8607_Simulator &);
+  Adafruit_MS8607_Simulator &operator=(const Adafruit_MS8607_Simulator &);
+
+  /** Transport for one of the simulated dies */
+  class Port final : public Adafruit_MS8607_Transport {
+  public:
+    /** @brief Create a port
+        @param sim The simulator
+        @param is_pt true for the pressure & temperature die */
+    Port(Adafruit_MS8607_Simulator *sim, bool is_pt)
+        : _sim(sim), _is_pt(is_pt) {}
+    ms8607_status_t begin(void);
+    ms8607_status_t write(const uint8_t *buffer, size_t len);
+    ms8607_status_t read(uint8_t *buffer, size_t len);
+    ms8607_status_t write_then_read(const uint8_t *write_buffer,
+                                    size_t write_len, uint8_t *read_buffer,
+                                    size_t read_len, bool stop = false);
+
+  private:
+    Adafruit_MS8607_Simulator *_sim; ///< The simulator
+    bool _is_pt; ///< true for the pressure & temperature die
+  };
+
+  ms8607_status_t _transfer(bool is_pt, const uint8_t *write_buffer,
+                            size_t write_len, uint8_t *read_buffer,
+                            size_t read_len);
+  ms8607_status_t _pt_transfer(const uint8_t *write_buffer, size_t write_len,
+                               uint8_t *read_buffer, size_t read_len);
+  ms8607_status_t _hum_transfer(const uint8_t *write_buffer,
+                                size_t write_len, uint8_t *read_buffer,
+                                size_t read_len);
+  void _charge(size_t bytes);
+  bool _done(uint32_t deadline_us);
+  uint32_t _hum_conversion_time(void);
+
+  Adafruit_MS8607_VirtualClock *_clock; ///< Time for conversions and bus
+  Port _pt;                             ///< Pressure & temperature die
+  Port _hum;                            ///< Humidity die
+
+  uint16_t _prom[8];             ///< PROM words including CRC
+  uint32_t _raw_pressure;        ///< D1 value returned by conversions
+  uint32_t _raw_temp;            ///< D2 value returned by conversions
+  uint16_t _raw_humidity;        ///< Humidity value returned
+  uint64_t _serial;              ///< Serial number of the humidity die
+  uint32_t _byte_ns;             ///< Time per byte on the bus
+  uint8_t _user_register = 0x02; ///< Humidity user register
+  bool _user_register_selected = false; ///< Next plain read is the register
+  uint8_t _pt_pending = 0;       ///< Conversion in progress, 0 for none
+  uint32_t _pt_done_us = 0;      ///< When the PT conversion ends
+  bool _hum_pending = false;     ///< Humidity conversion in progress
+  uint32_t _hum_done_us = 0;     ///< When the humidity conversion ends
+  ms8607_status_t _fault_status; ///< Status returned by injected faults
+  uint16_t _faults = 0;          ///< Remaining transactions to fail
+  uint16_t _fault_skip = 0;      ///< Transactions to pass before failing
+  uint32_t _transactions = 0;    ///< Transactions since resetCounters()
+  uint32_t _bus_us = 0;          ///< Bus time since resetCounters()
+  uint32_t _fraction_ns = 0;     ///< Bus time not yet charged to the clock
+};
+
+#endif
@@ -0,0 +1,73 @@
+/*!
+ *  @file Adafruit_MS8607_Transport.cpp
+ *
+ *  Bus access used by the MS8607 driver
+ *
+ *  MIT license, all text above must be included in any redistribution
+ */
+
+#include <Adafruit_MS8607_Transport.h>
+
+/*!
+ *    @brief  Instantiates a transport for a device on a TwoWire bus
+ *    @param  address The I2C address of the device
+ *    @param  wire The Wire object to be used for I2C connections
+ */
+Adafruit_MS8607_I2CTransport::Adafruit_MS8607_I2CTransport(uint8_t address,
+                                                           TwoWire *wire)
+    : _i2c_dev(address, wire) {}
+
+/**
+ * @brief Start the bus and check the device acknowledges its address
+ *
+ * @return ms8607_status_t MS8607_OK on success
+ */
+ms8607_status_t Adafruit_MS8607_I2CTransport::begin(void) {
+  return _i2c_dev.begin() ? MS8607_OK : MS8607_ERR_NACK;
+}
+
+/**
+ * @brief Write to the device
+ *
+ * @param buffer The bytes to write
+ * @param len The number of bytes to write
+ * @return ms8607_status_t MS8607_OK on success
+ */
+ms8607_status_t Adafruit_MS8607_I2CTransport::write(const uint8_t *buffer,
+                                                    size_t len) {
+  return _i2c_dev.write(buffer, len) ? MS8607_OK : MS8607_ERR_BUS;
+}
+
+/**
+ * @brief Read from the device
+ *
+ * @param buffer Where to store the bytes read
+ * @param len The number of bytes to read
+ * @return ms8607_status_t MS8607_OK on success
+ */
+ms8607_status_t Adafruit_MS8607_I2CTransport::read(uint8_t *buffer,
+                                                   size_t len) {
+  // a short read almost always means the address was not acknowledged
+  return _i2c_dev.read(buffer, len) ? MS8607_OK : MS8607_ERR_NACK;
+}
+
+/**
+ * @brief Write to the device then read from it
+ *
+ * @param write_buffer The bytes to write
+ * @param write_len The number of bytes to write
+ * @param read_buffer Where to store the bytes read
+ * @param read_len The number of bytes to read
+ * @param stop true: end the write with a stop condition, false: go straight
+ * on to the read with a repeated start
+ * @return ms8607_status_t MS8607_OK on success
+ */
+ms8607_status_t Adafruit_MS8607_I2CTransport::write_then_read(
+    const uint8_t *write_buffer, size_t write_len, uint8_t *read_buffer,
+    size_t read_len, bool stop) {
+  if (!_i2c_dev.write_then_read(write_buffer, write_len, read_buffer,
+                                read_len, stop)) {
+    return MS8607_ERR_BUS;
+  }
+  return MS8607_OK;
+}
@@ -0,0 +1,92 @@
+/*!
+ *  @file Adafruit_MS8607_Transport.h
+ *
+ *  Bus access used by the MS8607 driver. Each of the sensor's two dies is
+ *  reached through a transport, so the driver can run over buses other than
+ *  an Arduino TwoWire, or against a simulated sensor.
+ *
+ *  Transports are called through a virtual interface. Even at 400 kHz a
+ *  single byte takes over 20 us on the bus, so the few cycles of an
+ *  indirect call do not show up in measurements, and it keeps
+ *  Adafruit_MS8607 a plain class. Concrete transports are final so calls
+ *  through a known transport type are devirtualized.
+ *
+ *  MIT license, all text above must be included in any redistribution
+ */
+
+#ifndef __MS8607_TRANSPORT_H__
+#define __MS8607_TRANSPORT_H__
+
+#include "Arduino.h"
+#include <Adafruit_I2CDevice.h>
+
+/**
+ * @brief Result of a bus transaction, or of checking the data it returned
+ *
+ */
+typedef enum {
+  MS8607_OK = 0,      ///< Success
+  MS8607_ERR_NACK,    ///< The device did not acknowledge
+  MS8607_ERR_TIMEOUT, ///< The transaction did not complete in time
+  MS8607_ERR_BUS,     ///< Bus fault, or a failure the bus cannot classify
+  MS8607_ERR_INVALID, ///< The transport was not ready or arguments were bad
+  MS8607_ERR_CRC,     ///< Data read from the sensor failed its CRC check
+} ms8607_status_t;
+
+/**
+ * @brief Interface to one I2C device on the bus
+ *
+ */
+class Adafruit_MS8607_Transport {
+public:
+  virtual ~Adafruit_MS8607_Transport() {}
+
+  /** @brief Prepare the bus and check the device is present
+      @return ms8607_status_t MS8607_OK on success */
+  virtual ms8607_status_t begin(void) { return MS8607_OK; }
+  /** @brief Write to the device
+      @param buffer The bytes to write
+      @param len The number of bytes to write
+      @return ms8607_status_t MS8607_OK on success */
+  virtual ms8607_status_t write(const uint8_t *buffer, size_t len) = 0;
+  /** @brief Read from the device
+      @param buffer Where to store the bytes read
+      @param len The number of bytes to read
+      @return ms8607_status_t MS8607_OK on success */
+  virtual ms8607_status_t read(uint8_t *buffer, size_t len) = 0;
+  /** @brief Write to the device then read from it in one transaction
+      @param write_buffer The bytes to write
+      @param write_len The number of bytes to write
+      @param read_buffer Where to store the bytes read
+      @param read_len The number of bytes to read
+      @param stop true: end the write with a stop condition, false: go
+      straight on to the read with a repeated start
+      @return ms8607_status_t MS8607_OK on success */
+  virtual ms8607_status_t write_then_read(const uint8_t *write_buffer,
+                                          size_t write_len,
+                                          uint8_t *read_buffer,
+                                          size_t read_len,
+                                          bool stop = false) = 0;
+};
+
+/**
+ * @brief Transport over an Arduino TwoWire bus using Adafruit_I2CDevice.
+ * Adafruit_I2CDevice only reports success or failure, so failed probes and
+ * reads are reported as MS8607_ERR_NACK and other failures as MS8607_ERR_BUS
+ */
+class Adafruit_MS8607_I2CTransport final : public Adafruit_MS8607_Transport {
+public:
+  Adafruit_MS8607_I2CTransport(uint8_t address, TwoWire *wire = &Wire);
+
+  ms8607_status_t begin(void);
+  ms8607_status_t write(const uint8_t *buffer, size_t len);
+  ms8607_status_t read(uint8_t *buffer, size_t len);
+  ms8607_status_t write_then_read(const uint8_t *write_buffer,
+                                  size_t write_len, uint8_t *read_buffer,
+                                  size_t read_len, bool stop = false);
+
+private:
+  Adafruit_I2CDevice _i2c_dev; ///< The device on the bus
+};
+
+#endif
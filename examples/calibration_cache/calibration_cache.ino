@@ -0,0 +1,43 @@
+// Keep a copy of the sensor's calibration constants so that restarting the
+// driver does not read them from the sensor again. A duty-cycled node would
+// keep the copy in memory that survives sleep, such as RTC or backup RAM,
+// or in EEPROM. Here a restart is simulated by calling begin() again, and
+// the time from begin() to the first sample is printed with and without
+// the copy.
+#include <Wire.h>
+#include <Adafruit_MS8607.h>
+
+Adafruit_MS8607 ms8607;
+ms8607_calibration_t calibration;
+
+uint32_t timeBoot(void) {
+  uint32_t start = micros();
+  if (!ms8607.begin() || !ms8607.read()) {
+    Serial.println("Failed to read MS8607 chip");
+    while (1) { delay(10); }
+  }
+  return micros() - start;
+}
+
+void setup(void) {
+  Serial.begin(115200);
+  while (!Serial) delay(10);     // will pause Zero, Leonardo, etc until serial console opens
+
+  Serial.println("Adafruit MS8607 calibration cache test!");
+
+  Serial.print("Boot reading the PROM: "); Serial.print(timeBoot()); Serial.println(" us");
+
+  // save the constants read by begin()
+  ms8607.getCalibration(&calibration);
+
+  // on a real restart, load the saved copy here; it is checked against its
+  // CRC and rejected if it was corrupted
+  if (!ms8607.setCalibration(&calibration)) {
+    Serial.println("Saved calibration is corrupt, reading the PROM");
+  }
+  Serial.print("Boot with saved copy:  "); Serial.print(timeBoot()); Serial.println(" us");
+}
+
+void loop() {
+  delay(1000);
+}
@@ -0,0 +1,36 @@
+// Read an MS8607 whose settings are fixed when the sketch is compiled. The
+// driver is built for exactly this configuration, so it is smaller and
+// faster than one that checks its settings on every reading.
+#include <Wire.h>
+#include <Adafruit_MS8607_Fixed.h>
+
+// OSR 1024 pressure, 11 bit humidity, clock stretching and temperature
+// compensated humidity
+Adafruit_MS8607_Fixed<MS8607_PRESSURE_RESOLUTION_OSR_1024,
+                      MS8607_HUMIDITY_RESOLUTION_OSR_11b, true, true> ms8607;
+
+void setup(void) {
+  Serial.begin(115200);
+  while (!Serial) delay(10);     // will pause Zero, Leonardo, etc until serial console opens
+
+  Serial.println("Adafruit MS8607 fixed configuration test!");
+
+  if (!ms8607.begin()) {
+    Serial.println("Failed to find MS8607 chip");
+    while (1) { delay(10); }
+  }
+  Serial.print("Pressure conversion time: ");
+  Serial.print(ms8607.PT_CONVERSION_TIME); Serial.println(" us");
+}
+
+void loop() {
+  if (ms8607.read()) {
+    Serial.print("Temperature: "); Serial.print(ms8607.getTemperature()); Serial.println(" degrees C");
+    Serial.print("Pressure: "); Serial.print(ms8607.getPressure()); Serial.println(" hPa");
+    Serial.print("Humidity: "); Serial.print(ms8607.getHumidity()); Serial.println(" %rH");
+  } else {
+    Serial.println("Read failed");
+  }
+  Serial.println("");
+  delay(500);
+}
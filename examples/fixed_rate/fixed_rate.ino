@@ -0,0 +1,41 @@
+// Sample pressure, temperature and humidity at a fixed 50 Hz without blocking
+#include <Wire.h>
+#include <Adafruit_MS8607.h>
+#include <Adafruit_MS8607_Scheduler.h>
+
+Adafruit_MS8607 ms8607;
+Adafruit_MS8607_Scheduler scheduler(&ms8607);
+
+void setup(void) {
+  Serial.begin(115200);
+  while (!Serial) delay(10);     // will pause Zero, Leonardo, etc until serial console opens
+
+  Serial.println("Adafruit MS8607 fixed rate test!");
+
+  if (!ms8607.begin()) {
+    Serial.println("Failed to find MS8607 chip");
+    while (1) { delay(10); }
+  }
+  // 50 Hz needs each sample to fit in 20ms, so trade some resolution for speed
+  ms8607.setPressureResolution(MS8607_PRESSURE_RESOLUTION_OSR_2048);
+  ms8607.setHumidityResolution(MS8607_HUMIDITY_RESOLUTION_OSR_10b);
+
+  if (!scheduler.start(20000, micros())) {
+    Serial.println("Sample period is too short for the selected resolutions");
+    while (1) { delay(10); }
+  }
+}
+
+void loop() {
+  // tick often; the scheduler only touches the bus when a conversion is due
+  scheduler.tick(micros());
+
+  ms8607_sample_t sample;
+  while (scheduler.read(&sample)) {
+    Serial.print(sample.timestamp_us); Serial.print(", ");
+    Serial.print(sample.temperature); Serial.print(" C, ");
+    Serial.print(sample.pressure); Serial.print(" hPa, ");
+    Serial.print(sample.humidity); Serial.print(" %rH, missed: ");
+    Serial.println(scheduler.missedDeadlines());
+  }
+}
@@ -0,0 +1,37 @@
+// Small sketch used by tools/footprint.sh to measure the flash and RAM each
+// part of the driver takes. Define one of the FOOTPRINT_ options below when
+// building to use that part; with none defined the sensor is read through
+// the integer API only.
+#include <Adafruit_MS8607.h>
+
+#if defined(FOOTPRINT_FIXED)
+#include <Adafruit_MS8607_Fixed.h>
+Adafruit_MS8607_Fixed<> ms8607;
+#elif !defined(FOOTPRINT_EMPTY)
+Adafruit_MS8607 ms8607;
+#endif
+
+volatile int32_t result; // keeps the reads from being optimized out
+
+void setup(void) {
+#ifndef FOOTPRINT_EMPTY
+  ms8607.begin();
+#endif
+}
+
+void loop() {
+#if defined(FOOTPRINT_EMPTY)
+  result = micros();
+#elif defined(FOOTPRINT_UNIFIED_SENSOR)
+  sensors_event_t temp, pressure, humidity;
+  ms8607.getEvent(&pressure, &temp, &humidity);
+  result = temp.temperature + pressure.pressure + humidity.relative_humidity;
+#elif defined(FOOTPRINT_FLOAT)
+  ms8607.read();
+  result = ms8607.getTemperature() + ms8607.getPressure() + ms8607.getHumidity();
+#else
+  ms8607.read();
+  result = ms8607.getTemperatureX100() + ms8607.getPressureX100() +
+           ms8607.getHumidityX100();
+#endif
+}
@@ -0,0 +1,51 @@
+// Compare how long a full reading takes with and without humidity clock
+// stretching, and when polling for the end of the conversion. Stretching and
+// polling end the humidity read when the sensor finishes converting instead
+// of after a fixed worst-case wait.
+#include <Wire.h>
+#include <Adafruit_MS8607.h>
+#include <Adafruit_Sensor.h>
+
+#define READS 20
+
+Adafruit_MS8607 ms8607;
+
+uint32_t timeReads(void) {
+  sensors_event_t temp, pressure, humidity;
+  uint32_t total = 0;
+
+  for (int i = 0; i < READS; i++) {
+    uint32_t start = micros();
+    ms8607.getEvent(&pressure, &temp, &humidity);
+    total += micros() - start;
+  }
+  return total / READS;
+}
+
+void setup(void) {
+  Serial.begin(115200);
+  while (!Serial) delay(10);     // will pause Zero, Leonardo, etc until serial console opens
+
+  Serial.println("Adafruit MS8607 humidity latency test!");
+
+  if (!ms8607.begin()) {
+    Serial.println("Failed to find MS8607 chip");
+    while (1) { delay(10); }
+  }
+}
+
+void loop() {
+  ms8607.enableHumidityClockStretching(false);
+  ms8607.setHumidityPolling(0);
+  Serial.print("No hold: "); Serial.print(timeReads()); Serial.println(" us per reading");
+
+  ms8607.setHumidityPolling(500);
+  Serial.print("Polled:  "); Serial.print(timeReads()); Serial.println(" us per reading");
+
+  ms8607.setHumidityPolling(0);
+  ms8607.enableHumidityClockStretching(true);
+  Serial.print("Hold:    "); Serial.print(timeReads()); Serial.println(" us per reading");
+
+  Serial.println("");
+  delay(1000);
+}
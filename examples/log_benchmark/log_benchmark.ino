@@ -0,0 +1,80 @@
+// Compare the size and encoding time of the binary log with CSV. Samples
+// are a random walk like slowly changing weather, one a second, so no
+// sensor needs to be connected. Decode a real log on a computer with
+// tools/ms8607_log.py, which with --stats prints the same comparison.
+#include <Adafruit_MS8607.h>
+#include <Adafruit_MS8607_Log.h>
+
+#define SAMPLES 1000
+
+// counts the bytes written and throws them away, so only encoding is timed
+class ByteCounter : public Print {
+public:
+  size_t write(uint8_t) { count++; return 1; }
+  size_t write(const uint8_t *buffer, size_t size) { (void)buffer; count += size; return size; }
+  uint32_t count = 0;
+};
+
+Adafruit_MS8607_LogWriter logWriter;
+int32_t temperature, pressure, humidity;
+uint32_t timeMs;
+
+void nextSample(void) {
+  timeMs += 1000 + random(-2, 3);
+  temperature += random(-2, 3);
+  pressure += random(-4, 5);
+  humidity += random(-8, 9);
+}
+
+void restart(void) {
+  randomSeed(1);
+  timeMs = 0;
+  temperature = 2150;
+  pressure = 101325;
+  humidity = 4500;
+}
+
+void report(const char *name, uint32_t bytes, uint32_t us) {
+  Serial.print(name);
+  Serial.print(bytes / (float)SAMPLES); Serial.print(" bytes/sample, ");
+  Serial.print(us / (float)SAMPLES); Serial.print(" us/sample");
+#ifdef F_CPU
+  Serial.print(", "); Serial.print(us * (F_CPU / 1000000UL) / SAMPLES);
+  Serial.print(" cycles/sample");
+#endif
+  Serial.println("");
+}
+
+void setup(void) {
+  Serial.begin(115200);
+  while (!Serial) delay(10);     // will pause Zero, Leonardo, etc until serial console opens
+
+  Serial.println("Adafruit MS8607 log benchmark!");
+
+  // the random walk takes the same time in both runs and is included
+  ByteCounter binary;
+  restart();
+  logWriter.begin(&binary);
+  uint32_t start = micros();
+  for (int i = 0; i < SAMPLES; i++) {
+    nextSample();
+    logWriter.write(timeMs, temperature, pressure, humidity);
+  }
+  report("Binary log: ", binary.count, micros() - start);
+
+  ByteCounter csv;
+  restart();
+  start = micros();
+  for (int i = 0; i < SAMPLES; i++) {
+    nextSample();
+    csv.print(timeMs); csv.print(",");
+    csv.print(temperature / 100.0); csv.print(",");
+    csv.print(pressure / 100.0); csv.print(",");
+    csv.println(humidity / 100.0);
+  }
+  report("CSV:        ", csv.count, micros() - start);
+}
+
+void loop() {
+  delay(1000);
+}
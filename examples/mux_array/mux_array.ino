@@ -0,0 +1,43 @@
+// Read several MS8607s, each on its own channel of a TCA9548A multiplexer,
+// with their conversions overlapped
+#include <Wire.h>
+#include <Adafruit_MS8607.h>
+#include <Adafruit_MS8607_MuxArray.h>
+
+#define SENSOR_COUNT 4
+
+// sensor n is on channel n of the multiplexer at 0x70
+Adafruit_MS8607_MuxArray<SENSOR_COUNT> sensors;
+
+void setup(void) {
+  Serial.begin(115200);
+  while (!Serial) delay(10);     // will pause Zero, Leonardo, etc until serial console opens
+
+  Serial.println("Adafruit MS8607 multiplexer test!");
+
+  Wire.begin();
+  if (!sensors.begin()) {
+    Serial.println("Not all MS8607 chips were found");
+  }
+}
+
+void loop() {
+  uint32_t start = millis();
+  sensors.read();
+  Serial.print("Read "); Serial.print(SENSOR_COUNT);
+  Serial.print(" sensors in "); Serial.print(millis() - start); Serial.println(" ms");
+
+  for (uint8_t i = 0; i < SENSOR_COUNT; i++) {
+    Serial.print(i); Serial.print(": ");
+    if (!sensors.ok(i)) {
+      Serial.println("not responding");
+      continue;
+    }
+    Adafruit_MS8607 *ms8607 = sensors.getSensor(i);
+    Serial.print(ms8607->getTemperature()); Serial.print(" C, ");
+    Serial.print(ms8607->getPressure()); Serial.print(" hPa, ");
+    Serial.print(ms8607->getHumidity()); Serial.println(" %rH");
+  }
+  Serial.println("");
+  delay(500);
+}
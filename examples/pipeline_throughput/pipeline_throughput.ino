@@ -0,0 +1,53 @@
+// Show how pipelined reads scale with the number of sensors. Each MS8607 is
+// on its own channel of a TCA9548A multiplexer at 0x70.
+#include <Wire.h>
+#include <Adafruit_MS8607.h>
+#include <Adafruit_MS8607_Pipeline.h>
+
+#define SENSOR_COUNT 8
+#define MUX_ADDRESS 0x70
+
+Adafruit_MS8607 ms8607[SENSOR_COUNT];
+
+bool selectChannel(uint8_t index, void *context) {
+  (void)context;
+  Wire.beginTransmission(MUX_ADDRESS);
+  Wire.write(1 << index);
+  return Wire.endTransmission() == 0;
+}
+
+void setup(void) {
+  Serial.begin(115200);
+  while (!Serial) delay(10);     // will pause Zero, Leonardo, etc until serial console opens
+
+  Serial.println("Adafruit MS8607 pipeline throughput test!");
+
+  Wire.begin();
+  for (uint8_t i = 0; i < SENSOR_COUNT; i++) {
+    selectChannel(i, NULL);
+    if (!ms8607[i].begin()) {
+      Serial.print("Failed to find MS8607 chip on channel "); Serial.println(i);
+      while (1) { delay(10); }
+    }
+  }
+}
+
+void loop() {
+  for (uint8_t count = 1; count <= SENSOR_COUNT; count++) {
+    Adafruit_MS8607_Pipeline<SENSOR_COUNT> pipeline;
+    pipeline.setSelectCallback(selectChannel);
+    for (uint8_t i = 0; i < count; i++) {
+      pipeline.setSensor(i, &ms8607[i]);
+    }
+
+    uint32_t start = micros();
+    pipeline.read();
+    uint32_t elapsed = micros() - start;
+
+    Serial.print(count); Serial.print(" sensors: ");
+    Serial.print(elapsed); Serial.print(" us, ");
+    Serial.print(1000000.0 * count / elapsed); Serial.println(" readings/s");
+  }
+  Serial.println("");
+  delay(1000);
+}
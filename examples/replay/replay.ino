@@ -0,0 +1,57 @@
+// Replay a capture of raw readings through the driver. The capture below
+// was written by a driver built with -DMS8607_ENABLE_CAPTURE, by calling
+// startCapture() with an open file after begin(). Every read adds the raw
+// values to the file, which can be copied into a sketch like this one or
+// loaded from a file on a Linux host. Replaying takes no time on the
+// virtual clock and gives the same results on every run and board, so it
+// suits regression tests and benchmarks of code that processes readings.
+// No sensor needs to be connected.
+#include <Adafruit_MS8607.h>
+#include <Adafruit_MS8607_Replay.h>
+
+// header with the calibration, then readings with humidity every other one
+const uint8_t capture[] = {
+  0x4D, 0x53, 0x38, 0x36, 0x02, 0x00, 0x80, 0x24, 0xB5, 0xCD, 0xAB, 0x83,
+  0x71, 0xC2, 0x6C, 0x41, 0x7B, 0x05, 0x6E, 0x03, 0xCD, 0x84, 0x00, 0x00,
+  0x44, 0x41, 0x7B, 0xA4, 0xA7, 0x62, 0x74, 0xD3, 0x00, 0x00, 0x50, 0x6A,
+  0x01, 0x20, 0x18, 0x01, 0x00, 0x50, 0x3F, 0x7B, 0x8C, 0xAB, 0x62, 0x03,
+  0xCC, 0x5C, 0x01, 0x00, 0x5C, 0x3D, 0x7B, 0x74, 0xAF, 0x62, 0x73, 0xAB,
+  0x01, 0x00, 0xD0, 0x6A, 0x01, 0x1F, 0xF0, 0x01, 0x00, 0x68, 0x3B, 0x7B,
+  0x5C, 0xB3, 0x62, 0x03, 0xCB, 0x34, 0x02, 0x00, 0x74, 0x39, 0x7B, 0x44,
+  0xB7, 0x62, 0x72, 0x83, 0x02, 0x00, 0x50, 0x6B, 0x01, 0x1E, 0xC8, 0x02,
+  0x00, 0x80, 0x37, 0x7B, 0x2C, 0xBB, 0x62, 0x03, 0xCA, 0x0C, 0x03, 0x00,
+  0x8C, 0x35, 0x7B, 0x14, 0xBF, 0x62, 0x71, 0x5B, 0x03, 0x00, 0xD0, 0x6B,
+  0x01, 0x1D, 0xA0, 0x03, 0x00, 0x98, 0x33, 0x7B, 0xFC, 0xC2, 0x62};
+
+Adafruit_MS8607_VirtualClock virtualClock;
+Adafruit_MS8607_Replay replay(capture, sizeof(capture));
+Adafruit_MS8607 ms8607;
+
+void setup(void) {
+  Serial.begin(115200);
+  while (!Serial) delay(10);     // will pause Zero, Leonardo, etc until serial console opens
+
+  Serial.println("Adafruit MS8607 replay test!");
+
+  ms8607.setClock(&virtualClock);
+  if (!ms8607.begin(replay.getPTTransport(), replay.getHumidityTransport())) {
+    Serial.println("Not a capture this library can read");
+    while (1) { delay(10); }
+  }
+
+  while (!replay.atEnd()) {
+    // read humidity too where the capture did, to stay in step with it
+    if (!ms8607.read(replay.hasHumidity())) {
+      Serial.println("Replay failed");
+      break;
+    }
+    Serial.print("Captured at "); Serial.print(replay.getPTTime()); Serial.print(" us: ");
+    Serial.print(ms8607.getTemperatureX100()); Serial.print(" C x100, ");
+    Serial.print(ms8607.getPressureX100()); Serial.print(" hPa x100, ");
+    Serial.print(ms8607.getHumidityX100()); Serial.println(" %rH x100");
+  }
+}
+
+void loop() {
+  delay(1000);
+}
@@ -17,6 +17,15 @@ void setup(void) {
   }
   Serial.println("MS8607 Found!");
 
+  uint64_t serial;
+  if (ms8607.getSerialNumber(&serial)) {
+    Serial.print("Serial number: ");
+    for (int8_t shift = 60; shift >= 0; shift -= 4) {
+      Serial.print((uint8_t)(serial >> shift) & 0xF, HEX);
+    }
+    Serial.println("");
+  }
+
   ms8607.setHumidityResolution(MS8607_HUMIDITY_RESOLUTION_OSR_8b);
   Serial.print("Humidity resolution set to ");
   switch (ms8607.getHumidityResolution()){
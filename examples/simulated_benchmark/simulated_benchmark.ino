@@ -0,0 +1,129 @@
+// Benchmark the driver against a simulated MS8607. Time only passes on a
+// virtual clock, so results are the same on every board and show how long
+// a reading would take on a real bus, how much of that the bus is busy, and
+// how many transactions are used. No sensor needs to be connected.
+#include <Adafruit_MS8607.h>
+#include <Adafruit_MS8607_Pipeline.h>
+#include <Adafruit_MS8607_Simulator.h>
+#include <Adafruit_Sensor.h>
+
+#define SENSORS 8
+
+Adafruit_MS8607_VirtualClock virtualClock;
+Adafruit_MS8607_Simulator sim0(&virtualClock), sim1(&virtualClock),
+    sim2(&virtualClock), sim3(&virtualClock), sim4(&virtualClock),
+    sim5(&virtualClock), sim6(&virtualClock), sim7(&virtualClock);
+Adafruit_MS8607_Simulator *sims[SENSORS] = {&sim0, &sim1, &sim2, &sim3,
+                                            &sim4, &sim5, &sim6, &sim7};
+Adafruit_MS8607 ms8607[SENSORS];
+
+void timeRead(const char *name) {
+  sensors_event_t temp, pressure, humidity;
+
+  sims[0]->resetCounters();
+  uint32_t start = virtualClock.micros();
+  ms8607[0].getEvent(&pressure, &temp, &humidity);
+
+  Serial.print(name);
+  Serial.print(virtualClock.micros() - start); Serial.print(" us, bus busy ");
+  Serial.print(sims[0]->getBusMicros()); Serial.print(" us, ");
+  Serial.print(sims[0]->getTransactions()); Serial.println(" transactions");
+}
+
+#ifdef MS8607_ENABLE_STATS
+// print where the time in the driver's transactions went, when the library
+// is built with -DMS8607_ENABLE_STATS
+void printStats(void) {
+  const char *names[MS8607_OP_COUNT] = {"PT command", "ADC read", "PROM read",
+                                        "RH command", "RH read",
+                                        "User register", "Serial read"};
+  ms8607_stats_t stats;
+
+  ms8607[0].getStats(&stats);
+  for (int i = 0; i < MS8607_OP_COUNT; i++) {
+    Serial.print("  "); Serial.print(names[i]); Serial.print(": ");
+    Serial.print(stats.ops[i].count); Serial.print(" made, ");
+    Serial.print(stats.ops[i].failures); Serial.print(" failed, ");
+    Serial.print(stats.ops[i].min_us); Serial.print("/");
+    Serial.print(stats.ops[i].mean_us); Serial.print("/");
+    Serial.print(stats.ops[i].max_us); Serial.println(" us min/mean/max");
+  }
+}
+#endif
+
+void timeBoot(const char *name) {
+  sims[0]->resetCounters();
+  uint32_t start = virtualClock.micros();
+  ms8607[0].begin(sims[0]->getPTTransport(), sims[0]->getHumidityTransport());
+  ms8607[0].read();
+
+  Serial.print(name);
+  Serial.print(virtualClock.micros() - start); Serial.print(" us to first sample, ");
+  Serial.print(sims[0]->getTransactions()); Serial.println(" transactions");
+}
+
+void setup(void) {
+  Serial.begin(115200);
+  while (!Serial) delay(10);     // will pause Zero, Leonardo, etc until serial console opens
+
+  Serial.println("Adafruit MS8607 simulated benchmark!");
+
+  for (int i = 0; i < SENSORS; i++) {
+    ms8607[i].setClock(&virtualClock);
+    if (!ms8607[i].begin(sims[i]->getPTTransport(),
+                         sims[i]->getHumidityTransport())) {
+      Serial.println("Failed to start the simulated MS8607");
+      while (1) { delay(10); }
+    }
+  }
+
+  ms8607_calibration_t calibration;
+  timeBoot("Boot:         ");
+  ms8607[0].getCalibration(&calibration);
+  ms8607[0].setCalibration(&calibration);
+  timeBoot("Cached boot:  ");
+  ms8607[0].setCalibration(NULL);
+  // a failed PROM read is retried rather than failing begin(). The first
+  // PROM read follows the two address checks, two resets and the two reads
+  // of the serial number
+  sims[0]->injectFault(MS8607_ERR_NACK, 1, 6);
+  timeBoot("Boot, 1 NACK: ");
+
+  Serial.println("");
+  ms8607[0].enableHumidityClockStretching(false);
+  ms8607[0].setHumidityPolling(0);
+  timeRead("No hold: ");
+
+  ms8607[0].setHumidityPolling(500);
+#ifdef MS8607_ENABLE_STATS
+  ms8607[0].resetStats();
+#endif
+  timeRead("Polled:  ");
+#ifdef MS8607_ENABLE_STATS
+  printStats();
+#endif
+
+  ms8607[0].setHumidityPolling(0);
+  ms8607[0].enableHumidityClockStretching(true);
+  timeRead("Hold:    ");
+#ifdef MS8607_ENABLE_TRACE
+  // the transactions of the reads above, for tools/ms8607_trace.py
+  ms8607[0].dumpTrace(&Serial);
+#endif
+
+  Serial.println("");
+  for (int count = 1; count <= SENSORS; count *= 2) {
+    Adafruit_MS8607_Pipeline<SENSORS> pipeline;
+    for (int i = 0; i < count; i++) {
+      pipeline.setSensor(i, &ms8607[i]);
+    }
+    uint32_t start = virtualClock.micros();
+    pipeline.read();
+    Serial.print("Pipeline of "); Serial.print(count); Serial.print(": ");
+    Serial.print(virtualClock.micros() - start); Serial.println(" us");
+  }
+}
+
+void loop() {
+  delay(1000);
+}
@@ -0,0 +1,135 @@
+// Tests for Adafruit_MS8607::readAsync() against a simulated MS8607. Needs
+// C++20 coroutines, so run_tests.sh builds it with -std=c++20.
+#include <Adafruit_MS8607.h>
+#include <Adafruit_MS8607_Simulator.h>
+
+static int failures = 0;
+
+#define CHECK(cond)                                                            \
+  do {                                                                         \
+    if (!(cond)) {                                                             \
+      printf("%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #cond);          \
+      failures++;                                                              \
+    }                                                                          \
+  } while (0)
+
+#ifdef MS8607_HAS_COROUTINES
+
+// readings of the simulator's default raw values
+#define SIM_TEMPERATURE 2000
+#define SIM_PRESSURE 110002
+
+static const ms8607_recovery_policy_t no_recovery = {0, 0, 0};
+
+/**
+ * Run a read to completion, advancing the clock while it is suspended, and
+ * count the times it suspended
+ */
+static uint8_t run(Adafruit_MS8607_EventLoop *loop,
+                   Adafruit_MS8607_VirtualClock *clock,
+                   Adafruit_MS8607_Task *task) {
+  uint8_t suspensions = 0;
+
+  loop->spawn(*task);
+  while (loop->runOnce()) {
+    suspensions++;
+    clock->advance(100);
+  }
+  return suspensions;
+}
+
+static void test_read(void) {
+  Adafruit_MS8607_VirtualClock clock;
+  Adafruit_MS8607_Simulator sim(&clock);
+  Adafruit_MS8607_EventLoop loop(&clock);
+  Adafruit_MS8607 ms8607;
+
+  ms8607.setClock(&clock);
+  CHECK(ms8607.begin(sim.getPTTransport(), sim.getHumidityTransport()));
+
+  Adafruit_MS8607_Task read = ms8607.readAsync(loop);
+  CHECK(run(&loop, &clock, &read) > 0);
+  CHECK(read.done() && read.result());
+  CHECK(ms8607.getTemperatureX100() == SIM_TEMPERATURE);
+  CHECK(ms8607.getPressureX100() == SIM_PRESSURE);
+  CHECK(ms8607.getHumidityX100() > 0);
+}
+
+static void test_hold_mode_suspends(void) {
+  Adafruit_MS8607_VirtualClock clock;
+  Adafruit_MS8607_Simulator sim(&clock);
+  Adafruit_MS8607_EventLoop loop(&clock);
+  Adafruit_MS8607 ms8607;
+
+  ms8607.setClock(&clock);
+  CHECK(ms8607.begin(sim.getPTTransport(), sim.getHumidityTransport()));
+  CHECK(ms8607.enableHumidityClockStretching(true));
+
+  // the humidity conversion is waited for on the loop, not on the bus
+  Adafruit_MS8607_Task read = ms8607.readAsync(loop);
+  loop.spawn(read);
+  bool pending;
+  do {
+    uint32_t start_us = clock.micros();
+    pending = loop.runOnce();
+    CHECK(clock.micros() - start_us < ms8607.getHumidityConversionTime());
+    clock.advance(ms8607.getPTConversionTime());
+  } while (pending);
+  CHECK(read.done() && read.result());
+  CHECK(ms8607.getHumidityX100() > 0);
+}
+
+static void test_failure_is_recovered(void) {
+  Adafruit_MS8607_VirtualClock clock;
+  Adafruit_MS8607_Simulator sim(&clock);
+  Adafruit_MS8607_EventLoop loop(&clock);
+  Adafruit_MS8607 ms8607;
+  ms8607_recovery_policy_t reset_at_once = {0, 0, 1};
+  ms8607_recovery_counters_t counters;
+
+  ms8607.setClock(&clock);
+  CHECK(ms8607.begin(sim.getPTTransport(), sim.getHumidityTransport()));
+
+  // without recovery the failed read is counted
+  ms8607.setRecoveryPolicy(&no_recovery);
+  sim.injectFault(MS8607_ERR_BUS);
+  Adafruit_MS8607_Task failed = ms8607.readAsync(loop);
+  run(&loop, &clock, &failed);
+  CHECK(failed.done() && !failed.result());
+  ms8607.getRecoveryCounters(&counters);
+  CHECK(counters.failures == 1);
+
+  // with it, a reset is followed by a second attempt
+  ms8607.resetRecoveryCounters();
+  ms8607.setRecoveryPolicy(&reset_at_once);
+  sim.injectFault(MS8607_ERR_BUS);
+  Adafruit_MS8607_Task recovered = ms8607.readAsync(loop);
+  run(&loop, &clock, &recovered);
+  CHECK(recovered.done() && recovered.result());
+  ms8607.getRecoveryCounters(&counters);
+  CHECK(counters.resets == 1);
+  CHECK(counters.failures == 0);
+  CHECK(ms8607.getTemperatureX100() == SIM_TEMPERATURE);
+}
+
+int main(void) {
+  test_read();
+  test_hold_mode_suspends();
+  test_failure_is_recovered();
+
+  if (failures) {
+    printf("async_test: %d checks failed\n", failures);
+    return 1;
+  }
+  printf("async_test: all checks passed\n");
+  return 0;
+}
+
+#else
+
+int main(void) {
+  printf("async_test: skipped, the compiler has no coroutines\n");
+  return 0;
+}
+
+#endif // MS8607_HAS_COROUTINES
@@ -0,0 +1,67 @@
+// Tests for the calibration and conversion code shared by the driver, the
+// simulator and the replay, against values from the datasheets.
+#include <Adafruit_MS8607.h>
+
+static int failures = 0;
+
+#define CHECK(cond)                                                            \
+  do {                                                                         \
+    if (!(cond)) {                                                             \
+      printf("%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #cond);          \
+      failures++;                                                              \
+    }                                                                          \
+  } while (0)
+
+static void test_humidity_crc(void) {
+  // examples from the HTU21D datasheet
+  const uint8_t a[2] = {0x68, 0x3A}, b[2] = {0x4E, 0x85};
+  CHECK(ms8607_humidity_crc(a, 2) == 0x7C);
+  CHECK(ms8607_humidity_crc(b, 2) == 0x6B);
+
+  const uint8_t reading[3] = {0x68, 0x3A, 0x7C};
+  uint16_t raw = 0;
+  CHECK(ms8607_parse_humidity(reading, &raw));
+  CHECK(raw == 0x683A);
+  const uint8_t corrupt[3] = {0x68, 0x3B, 0x7C};
+  CHECK(!ms8607_parse_humidity(corrupt, &raw));
+}
+
+static void test_prom_crc(void) {
+  // the datasheet's example coefficients, with their CRC computed
+  // separately with the algorithm from application note AN520
+  uint16_t prom[7] = {0x8000, 46372, 43981, 29059, 27842, 31553, 28165};
+  ms8607_calibration_t calibration = {prom[0], prom[1], prom[2], prom[3],
+                                      prom[4], prom[5], prom[6]};
+
+  CHECK(ms8607_prom_crc(prom) == 0x8);
+  // the CRC bits of word 0 are not part of the CRC
+  prom[0] = 0x0000;
+  CHECK(ms8607_prom_crc(prom) == 0x8);
+  CHECK(ms8607_check_calibration(&calibration));
+  calibration.ref_temp ^= 1;
+  CHECK(!ms8607_check_calibration(&calibration));
+}
+
+static void test_compensation(void) {
+  const ms8607_calibration_t calibration = {0x8000, 46372, 43981, 29059,
+                                            27842,  31553, 28165};
+  int32_t temperature, pressure;
+
+  ms8607_compensate_pt(&calibration, 8077636, 6465444, &temperature,
+                       &pressure);
+  CHECK(temperature == 2000);
+  CHECK(pressure == 110002);
+}
+
+int main(void) {
+  test_humidity_crc();
+  test_prom_crc();
+  test_compensation();
+
+  if (failures) {
+    printf("compensation_test: %d checks failed\n", failures);
+    return 1;
+  }
+  printf("compensation_test: all checks passed\n");
+  return 0;
+}
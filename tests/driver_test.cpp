@@ -0,0 +1,205 @@
+// Tests for how Adafruit_MS8607 handles bus errors, run against a simulated
+// MS8607 with faults injected into chosen transactions.
+#include <Adafruit_MS8607.h>
+#include <Adafruit_MS8607_Simulator.h>
+
+static int failures = 0;
+
+#define CHECK(cond)                                                            \
+  do {                                                                         \
+    if (!(cond)) {                                                             \
+      printf("%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #cond);          \
+      failures++;                                                              \
+    }                                                                          \
+  } while (0)
+
+// transactions begin() makes before its resets: one probe of each die
+#define BEGIN_PROBES 2
+// transactions begin() makes before it reads the PROM: the probes, a reset
+// of each die and the two reads of the serial number
+#define BEGIN_BEFORE_PROM 6
+
+static const ms8607_recovery_policy_t no_recovery = {0, 0, 0};
+
+/**
+ * Passes transactions on, counting user register reads, and can lose the
+ * data of the next ADC read
+ */
+class LossyTransport : public Adafruit_MS8607_Transport {
+public:
+  LossyTransport(Adafruit_MS8607_Transport *transport)
+      : _transport(transport) {}
+  ms8607_status_t begin(void) { return _transport->begin(); }
+  ms8607_status_t write(const uint8_t *buffer, size_t len) {
+    return _transport->write(buffer, len);
+  }
+  ms8607_status_t read(uint8_t *buffer, size_t len) {
+    return _transport->read(buffer, len);
+  }
+  ms8607_status_t write_then_read(const uint8_t *write_buffer,
+                                  size_t write_len, uint8_t *read_buffer,
+                                  size_t read_len, bool stop = false) {
+    ms8607_status_t status = _transport->write_then_read(
+        write_buffer, write_len, read_buffer, read_len, stop);
+    if (write_buffer[0] == HSENSOR_READ_USER_REG_COMMAND) {
+      user_register_reads++;
+      user_register_stops += stop;
+    }
+    if (lose_adc_read && write_buffer[0] == PSENSOR_READ_ADC) {
+      // the sensor gave its result, but it did not arrive
+      lose_adc_read = false;
+      return MS8607_ERR_BUS;
+    }
+    return status;
+  }
+  bool lose_adc_read = false;
+  uint8_t user_register_reads = 0;
+  uint8_t user_register_stops = 0;
+
+private:
+  Adafruit_MS8607_Transport *_transport;
+};
+
+static void test_begin_fails_when_reset_fails(void) {
+  Adafruit_MS8607_VirtualClock clock;
+  Adafruit_MS8607_Simulator sim(&clock);
+  Adafruit_MS8607 ms8607;
+
+  ms8607.setClock(&clock);
+  sim.injectFault(MS8607_ERR_BUS, 3, BEGIN_PROBES);
+  CHECK(!ms8607.begin(sim.getPTTransport(), sim.getHumidityTransport()));
+  CHECK(ms8607.getStatus() == MS8607_ERR_BUS);
+}
+
+static void test_polling_stops_on_bus_error(void) {
+  Adafruit_MS8607_VirtualClock clock;
+  Adafruit_MS8607_Simulator sim(&clock);
+  Adafruit_MS8607 ms8607;
+
+  ms8607.setClock(&clock);
+  CHECK(ms8607.begin(sim.getPTTransport(), sim.getHumidityTransport()));
+  ms8607.setRecoveryPolicy(&no_recovery);
+  ms8607.setHumidityPolling(1000, 20000);
+  CHECK(ms8607.read());
+
+  // the first poll comes after the two PT conversions and the start of
+  // the humidity conversion
+  sim.injectFault(MS8607_ERR_BUS, 1, 5);
+  uint32_t start_us = clock.micros();
+  CHECK(!ms8607.read());
+  CHECK(ms8607.getStatus() == MS8607_ERR_BUS);
+  CHECK(clock.micros() - start_us < 20000);
+
+  // NACKs only mean the conversion is still running
+  sim.injectFault(MS8607_ERR_NACK, 3, 5);
+  CHECK(ms8607.read());
+  CHECK(ms8607.getStatus() == MS8607_OK);
+}
+
+static void test_serial_read_is_retried(void) {
+  Adafruit_MS8607_VirtualClock clock;
+  Adafruit_MS8607_Simulator sim(&clock);
+  Adafruit_MS8607 ms8607, strict;
+  uint64_t serial;
+
+  // one NACK of the first serial number read is retried
+  ms8607.setClock(&clock);
+  sim.injectFault(MS8607_ERR_NACK, 1, BEGIN_PROBES + 2);
+  CHECK(ms8607.begin(sim.getPTTransport(), sim.getHumidityTransport()));
+  CHECK(ms8607.getSerialNumber(&serial));
+  CHECK(serial == MS8607_SIM_SERIAL);
+
+  // without retries the NACK leaves the default IDs
+  strict.setClock(&clock);
+  strict.setRecoveryPolicy(&no_recovery);
+  sim.injectFault(MS8607_ERR_NACK, 1, BEGIN_PROBES + 2);
+  CHECK(strict.begin(sim.getPTTransport(), sim.getHumidityTransport()));
+  CHECK(!strict.getSerialNumber(&serial));
+#ifndef MS8607_NO_UNIFIED_SENSOR
+  sensor_t sensor;
+  strict.getTemperatureSensor()->getSensor(&sensor);
+  CHECK(sensor.sensor_id == MS8607_DEFAULT_SENSOR_ID);
+#endif
+}
+
+static void test_bus_error_reading_serial_fails_begin(void) {
+  Adafruit_MS8607_VirtualClock clock;
+  Adafruit_MS8607_Simulator sim(&clock);
+  Adafruit_MS8607 ms8607;
+
+  ms8607.setClock(&clock);
+  ms8607.setRecoveryPolicy(&no_recovery);
+  sim.injectFault(MS8607_ERR_BUS, 1, BEGIN_PROBES + 2);
+  CHECK(!ms8607.begin(sim.getPTTransport(), sim.getHumidityTransport()));
+  CHECK(ms8607.getStatus() == MS8607_ERR_BUS);
+}
+
+static void test_lost_adc_result_is_not_accepted(void) {
+  Adafruit_MS8607_VirtualClock clock;
+  Adafruit_MS8607_Simulator sim(&clock);
+  LossyTransport pt(sim.getPTTransport());
+  Adafruit_MS8607 ms8607;
+
+  ms8607.setClock(&clock);
+  CHECK(ms8607.begin(&pt, sim.getHumidityTransport()));
+  CHECK(ms8607.read(false));
+  int32_t temperature = ms8607.getTemperatureX100();
+
+  // the retry reads the consumed result as 0
+  pt.lose_adc_read = true;
+  CHECK(!ms8607.read(false));
+  CHECK(ms8607.getStatus() == MS8607_ERR_BUS);
+  CHECK(ms8607.getTemperatureX100() == temperature);
+  CHECK(ms8607.read(false));
+}
+
+static void test_user_register_read_ends_write_with_stop(void) {
+  Adafruit_MS8607_VirtualClock clock;
+  Adafruit_MS8607_Simulator sim(&clock);
+  LossyTransport hum(sim.getHumidityTransport());
+  Adafruit_MS8607 ms8607;
+
+  ms8607.setClock(&clock);
+  CHECK(ms8607.begin(sim.getPTTransport(), &hum));
+  CHECK(ms8607.setHumidityResolution(MS8607_HUMIDITY_RESOLUTION_OSR_8b));
+  CHECK(hum.user_register_reads > 0);
+  CHECK(hum.user_register_stops == hum.user_register_reads);
+}
+
+static void test_prom_follows_recovery_policy(void) {
+  Adafruit_MS8607_VirtualClock clock;
+  Adafruit_MS8607_Simulator sim(&clock);
+  Adafruit_MS8607 patient, impatient;
+  ms8607_recovery_policy_t policy = {3, 100, 0};
+  ms8607_recovery_counters_t counters;
+
+  patient.setClock(&clock);
+  patient.setRecoveryPolicy(&policy);
+  sim.injectFault(MS8607_ERR_NACK, 3, BEGIN_BEFORE_PROM);
+  CHECK(patient.begin(sim.getPTTransport(), sim.getHumidityTransport()));
+  patient.getRecoveryCounters(&counters);
+  CHECK(counters.retries == 3);
+
+  impatient.setClock(&clock);
+  impatient.setRecoveryPolicy(&no_recovery);
+  sim.injectFault(MS8607_ERR_NACK, 1, BEGIN_BEFORE_PROM);
+  CHECK(!impatient.begin(sim.getPTTransport(), sim.getHumidityTransport()));
+  CHECK(impatient.getStatus() == MS8607_ERR_NACK);
+}
+
+int main(void) {
+  test_begin_fails_when_reset_fails();
+  test_polling_stops_on_bus_error();
+  test_serial_read_is_retried();
+  test_bus_error_reading_serial_fails_begin();
+  test_lost_adc_result_is_not_accepted();
+  test_user_register_read_ends_write_with_stop();
+  test_prom_follows_recovery_policy();
+
+  if (failures) {
+    printf("driver_test: %d checks failed\n", failures);
+    return 1;
+  }
+  printf("driver_test: all checks passed\n");
+  return 0;
+}
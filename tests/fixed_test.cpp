@@ -0,0 +1,98 @@
+// Tests for Adafruit_MS8607_Fixed, run against a simulated MS8607.
+#include <Adafruit_MS8607_Fixed.h>
+#include <Adafruit_MS8607_Simulator.h>
+
+static int failures = 0;
+
+#define CHECK(cond)                                                            \
+  do {                                                                         \
+    if (!(cond)) {                                                             \
+      printf("%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #cond);          \
+      failures++;                                                              \
+    }                                                                          \
+  } while (0)
+
+// readings of the simulator's default raw values
+#define SIM_TEMPERATURE 2000
+#define SIM_PRESSURE 110002
+
+// transactions of a read without hold before the humidity result: two
+// conversion commands, two ADC reads and the humidity command
+#define READ_BEFORE_HUMIDITY 5
+
+typedef Adafruit_MS8607_Fixed<> Fixed;
+typedef Adafruit_MS8607_Fixed<MS8607_PRESSURE_RESOLUTION_OSR_256,
+                              MS8607_HUMIDITY_RESOLUTION_OSR_8b, true>
+    FixedHold;
+
+template <class Driver> static void test_read(void) {
+  Adafruit_MS8607_VirtualClock clock;
+  Adafruit_MS8607_Simulator sim(&clock);
+  Driver ms8607;
+
+  ms8607.setClock(&clock);
+  CHECK(ms8607.begin(sim.getPTTransport(), sim.getHumidityTransport()));
+  CHECK(ms8607.read());
+  CHECK(ms8607.getStatus() == MS8607_OK);
+  CHECK(ms8607.getTemperatureX100() == SIM_TEMPERATURE);
+  CHECK(ms8607.getPressureX100() == SIM_PRESSURE);
+  CHECK(ms8607.getHumidityX100() > 0);
+  CHECK(ms8607.read(false));
+  CHECK(ms8607.getTemperatureX100() == SIM_TEMPERATURE);
+}
+
+static void test_zero_adc_result_is_rejected(void) {
+  Adafruit_MS8607_VirtualClock clock;
+  Adafruit_MS8607_Simulator sim(&clock);
+  Fixed ms8607;
+
+  ms8607.setClock(&clock);
+  CHECK(ms8607.begin(sim.getPTTransport(), sim.getHumidityTransport()));
+  CHECK(ms8607.read());
+  int32_t humidity = ms8607.getHumidityX100();
+
+  // a result of 0 means no conversion was done, and keeps the last reading
+  sim.setRawValues(0, 0, 0);
+  CHECK(!ms8607.read());
+  CHECK(ms8607.getStatus() == MS8607_ERR_BUS);
+  CHECK(ms8607.getTemperatureX100() == SIM_TEMPERATURE);
+  CHECK(ms8607.getPressureX100() == SIM_PRESSURE);
+  CHECK(ms8607.getHumidityX100() == humidity);
+}
+
+static void test_failed_humidity_keeps_reading(void) {
+  Adafruit_MS8607_VirtualClock clock;
+  Adafruit_MS8607_Simulator sim(&clock);
+  Fixed ms8607;
+
+  ms8607.setClock(&clock);
+  CHECK(ms8607.begin(sim.getPTTransport(), sim.getHumidityTransport()));
+  CHECK(ms8607.read());
+  int32_t humidity = ms8607.getHumidityX100();
+
+  // the new pressure & temperature are not stored without their humidity
+  sim.setRawValues(8077636, 6465444, 0x6A50);
+  sim.injectFault(MS8607_ERR_BUS, 1, READ_BEFORE_HUMIDITY);
+  CHECK(!ms8607.read());
+  CHECK(ms8607.getStatus() == MS8607_ERR_BUS);
+  CHECK(ms8607.getTemperatureX100() == SIM_TEMPERATURE);
+  CHECK(ms8607.getPressureX100() == SIM_PRESSURE);
+  CHECK(ms8607.getHumidityX100() == humidity);
+
+  CHECK(ms8607.read());
+  CHECK(ms8607.getTemperatureX100() != SIM_TEMPERATURE);
+}
+
+int main(void) {
+  test_read<Fixed>();
+  test_read<FixedHold>();
+  test_zero_adc_result_is_rejected();
+  test_failed_humidity_keeps_reading();
+
+  if (failures) {
+    printf("fixed_test: %d checks failed\n", failures);
+    return 1;
+  }
+  printf("fixed_test: all checks passed\n");
+  return 0;
+}
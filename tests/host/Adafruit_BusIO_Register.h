@@ -0,0 +1 @@
+// Not used by the tests
@@ -0,0 +1,54 @@
+// The Adafruit_I2CDevice used by the library's Adafruit_MS8607_I2CTransport,
+// passing each transaction to the devices a test put on the bus. With none,
+// nothing answers; most tests pass their own transports to begin() instead.
+#include "Adafruit_I2CDevice.h"
+
+TwoWire Wire;
+
+Adafruit_I2CDevice::Adafruit_I2CDevice(uint8_t addr, TwoWire *theWire) {
+  _addr = addr;
+  _wire = theWire;
+}
+
+bool Adafruit_I2CDevice::begin(bool addr_detect) {
+  return !addr_detect || _transfer(NULL, 0, NULL, 0);
+}
+
+bool Adafruit_I2CDevice::read(uint8_t *buffer, size_t len, bool stop) {
+  (void)stop;
+  return _transfer(NULL, 0, buffer, len);
+}
+
+bool Adafruit_I2CDevice::write(const uint8_t *buffer, size_t len, bool stop,
+                               const uint8_t *prefix_buffer,
+                               size_t prefix_len) {
+  uint8_t joined[32];
+
+  (void)stop;
+  if (prefix_len + len > sizeof(joined)) {
+    return false;
+  }
+  if (prefix_len) {
+    memcpy(joined, prefix_buffer, prefix_len);
+  }
+  if (len) {
+    memcpy(joined + prefix_len, buffer, len);
+  }
+  return _transfer(joined, prefix_len + len, NULL, 0);
+}
+
+bool Adafruit_I2CDevice::write_then_read(const uint8_t *write_buffer,
+                                         size_t write_len,
+                                         uint8_t *read_buffer,
+                                         size_t read_len, bool stop) {
+  (void)stop;
+  return _transfer(write_buffer, write_len, read_buffer, read_len);
+}
+
+bool Adafruit_I2CDevice::_transfer(const uint8_t *write_buffer,
+                                   size_t write_len, uint8_t *read_buffer,
+                                   size_t read_len) {
+  return _wire->devices && _wire->devices->transfer(_addr, write_buffer,
+                                                    write_len, read_buffer,
+                                                    read_len);
+}
@@ -0,0 +1,26 @@
+// The parts of Adafruit_I2CDevice the library uses
+#ifndef __MS8607_TEST_I2CDEVICE_H__
+#define __MS8607_TEST_I2CDEVICE_H__
+
+#include "Wire.h"
+
+class Adafruit_I2CDevice {
+public:
+  Adafruit_I2CDevice(uint8_t addr, TwoWire *theWire = &Wire);
+  bool begin(bool addr_detect = true);
+  bool read(uint8_t *buffer, size_t len, bool stop = true);
+  bool write(const uint8_t *buffer, size_t len, bool stop = true,
+             const uint8_t *prefix_buffer = NULL, size_t prefix_len = 0);
+  bool write_then_read(const uint8_t *write_buffer, size_t write_len,
+                       uint8_t *read_buffer, size_t read_len,
+                       bool stop = false);
+
+private:
+  bool _transfer(const uint8_t *write_buffer, size_t write_len,
+                 uint8_t *read_buffer, size_t read_len);
+
+  uint8_t _addr;
+  TwoWire *_wire;
+};
+
+#endif
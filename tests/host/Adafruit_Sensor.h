@@ -0,0 +1,45 @@
+// The parts of Adafruit Unified Sensor the driver's headers use
+#ifndef __MS8607_TEST_SENSOR_H__
+#define __MS8607_TEST_SENSOR_H__
+
+#include "Arduino.h"
+
+typedef enum {
+  SENSOR_TYPE_PRESSURE = 6,
+  SENSOR_TYPE_RELATIVE_HUMIDITY = 12,
+  SENSOR_TYPE_AMBIENT_TEMPERATURE = 13,
+} sensors_type_t;
+
+typedef struct {
+  int32_t version;
+  int32_t sensor_id;
+  int32_t type;
+  int32_t reserved0;
+  int32_t timestamp;
+  union {
+    float data[4];
+    float temperature;
+    float pressure;
+    float relative_humidity;
+  };
+} sensors_event_t;
+
+typedef struct {
+  char name[12];
+  int32_t version;
+  int32_t sensor_id;
+  int32_t type;
+  float max_value;
+  float min_value;
+  float resolution;
+  int32_t min_delay;
+} sensor_t;
+
+class Adafruit_Sensor {
+public:
+  virtual ~Adafruit_Sensor() {}
+  virtual bool getEvent(sensors_event_t *) = 0;
+  virtual void getSensor(sensor_t *) = 0;
+};
+
+#endif
@@ -0,0 +1,48 @@
+// Minimal Arduino core for building the library's tests on a Linux host.
+// Time comes from the host's monotonic clock.
+#ifndef __MS8607_TEST_ARDUINO_H__
+#define __MS8607_TEST_ARDUINO_H__
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+inline uint32_t micros(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint32_t)(ts.tv_sec * 1000000ULL + ts.tv_nsec / 1000);
+}
+inline uint32_t millis(void) { return micros() / 1000; }
+inline void delayMicroseconds(unsigned int us) {
+  uint32_t start = micros();
+  while (micros() - start < us) {
+  }
+}
+inline void delay(uint32_t ms) { delayMicroseconds(ms * 1000); }
+
+#define HEX 16
+#define DEC 10
+
+class Print {
+public:
+  virtual ~Print() {}
+  virtual size_t write(uint8_t c) = 0;
+  virtual size_t write(const uint8_t *buffer, size_t len) {
+    size_t n = 0;
+    while (len--) {
+      n += write(*buffer++);
+    }
+    return n;
+  }
+  size_t print(const char *s) { return write((const uint8_t *)s, strlen(s)); }
+  size_t print(unsigned long value, int base = DEC) {
+    char buffer[24];
+    snprintf(buffer, sizeof(buffer), base == HEX ? "%lX" : "%lu", value);
+    return print(buffer);
+  }
+  size_t println(const char *s = "") { return print(s) + print("\n"); }
+};
+
+#endif
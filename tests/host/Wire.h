@@ -0,0 +1,50 @@
+// A TwoWire with no devices unless a test puts a model of them on it
+#ifndef __MS8607_TEST_WIRE_H__
+#define __MS8607_TEST_WIRE_H__
+
+#include "Arduino.h"
+
+/** The devices a test puts on a bus */
+class HostI2CDevices {
+public:
+  virtual ~HostI2CDevices() {}
+  /**
+   * One transaction with the device at an address: a write, a read, a
+   * write then a read, or neither to probe the address. Returns false if
+   * the device did not acknowledge
+   */
+  virtual bool transfer(uint8_t address, const uint8_t *write_buffer,
+                        size_t write_len, uint8_t *read_buffer,
+                        size_t read_len) = 0;
+};
+
+class TwoWire {
+public:
+  void beginTransmission(uint8_t address) {
+    _address = address;
+    _len = 0;
+  }
+  size_t write(uint8_t data) {
+    if (_len >= sizeof(_buffer)) {
+      return 0;
+    }
+    _buffer[_len++] = data;
+    return 1;
+  }
+  uint8_t endTransmission(bool stop = true) {
+    (void)stop;
+    // 2: the address was not acknowledged
+    return devices && devices->transfer(_address, _buffer, _len, NULL, 0) ? 0
+                                                                          : 2;
+  }
+
+  HostI2CDevices *devices = NULL; ///< What answers on the bus, or nothing
+
+private:
+  uint8_t _address = 0;
+  uint8_t _buffer[32];
+  size_t _len = 0;
+};
+extern TwoWire Wire;
+
+#endif
@@ -0,0 +1,256 @@
+// Tests for Adafruit_MS8607_LinuxI2C. The test defines open(), close() and
+// ioctl() itself, which the linker uses in place of the C library's, and
+// answers I2C_RDWR by passing the messages to a simulated MS8607, so the
+// transport runs unchanged without an i2c-dev bus.
+#include <Adafruit_MS8607.h>
+#include <Adafruit_MS8607_LinuxI2C.h>
+#include <Adafruit_MS8607_Simulator.h>
+
+#include <errno.h>
+#include <linux/i2c-dev.h>
+#include <linux/i2c.h>
+#include <stdarg.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#define FAKE_FD 1000 ///< Descriptor returned for the fake bus
+
+static Adafruit_MS8607_VirtualClock sim_clock;
+static Adafruit_MS8607_Simulator sim(&sim_clock);
+
+static int open_errno = 0;          // errno for open() to fail with, or 0
+static unsigned long funcs;         // adapter functionality for I2C_FUNCS
+static int funcs_errno = 0;         // errno for I2C_FUNCS to fail with, or 0
+static int rdwr_errno = 0;          // errno for I2C_RDWR to fail with, or 0
+static int rdwr_calls = 0;          // I2C_RDWR ioctls issued
+static uint32_t last_nmsgs;         // messages in the last I2C_RDWR
+static struct i2c_msg last_msgs[2]; // copy of them
+static int failures = 0;
+
+extern "C" int open(const char *path, int flags, ...) {
+  (void)path;
+  (void)flags;
+  if (open_errno) {
+    errno = open_errno;
+    return -1;
+  }
+  return FAKE_FD;
+}
+
+extern "C" int close(int fd) {
+  if (fd == FAKE_FD) {
+    return 0;
+  }
+  return syscall(SYS_close, fd);
+}
+
+static ms8607_status_t sim_transfer(struct i2c_msg *msgs, uint32_t n) {
+  Adafruit_MS8607_Transport *dev = msgs[0].addr == MS8607_PT_ADDRESS
+                                       ? sim.getPTTransport()
+                                       : sim.getHumidityTransport();
+  if (n == 2) {
+    return dev->write_then_read(msgs[0].buf, msgs[0].len, msgs[1].buf,
+                                msgs[1].len);
+  }
+  if (msgs[0].flags & I2C_M_RD) {
+    return dev->read(msgs[0].buf, msgs[0].len);
+  }
+  if (msgs[0].len == 0) {
+    return MS8607_OK; // address probe
+  }
+  return dev->write(msgs[0].buf, msgs[0].len);
+}
+
+extern "C" int ioctl(int fd, unsigned long request, ...) {
+  va_list args;
+  va_start(args, request);
+  void *arg = va_arg(args, void *);
+  va_end(args);
+
+  if (fd != FAKE_FD) {
+    errno = EBADF;
+    return -1;
+  }
+  if (request == I2C_FUNCS) {
+    if (funcs_errno) {
+      errno = funcs_errno;
+      return -1;
+    }
+    *(unsigned long *)arg = funcs;
+    return 0;
+  }
+  if (request != I2C_RDWR) {
+    errno = ENOTTY;
+    return -1;
+  }
+  struct i2c_rdwr_ioctl_data *data = (struct i2c_rdwr_ioctl_data *)arg;
+  rdwr_calls++;
+  last_nmsgs = data->nmsgs;
+  for (uint32_t i = 0; i < data->nmsgs && i < 2; i++) {
+    last_msgs[i] = data->msgs[i];
+  }
+  if (rdwr_errno) {
+    errno = rdwr_errno;
+    return -1;
+  }
+  if (sim_transfer(data->msgs, data->nmsgs) != MS8607_OK) {
+    errno = ENXIO;
+    return -1;
+  }
+  return data->nmsgs;
+}
+
+#define CHECK(cond)                                                            \
+  do {                                                                         \
+    if (!(cond)) {                                                             \
+      printf("%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #cond);          \
+      failures++;                                                              \
+    }                                                                          \
+  } while (0)
+
+static void reset_fakes(void) {
+  open_errno = 0;
+  funcs = I2C_FUNC_I2C | I2C_FUNC_SMBUS_QUICK;
+  funcs_errno = 0;
+  rdwr_errno = 0;
+  rdwr_calls = 0;
+  last_nmsgs = 0;
+}
+
+static void test_begin_probes_address(void) {
+  reset_fakes();
+  Adafruit_MS8607_LinuxI2C pt("/dev/i2c-1", MS8607_PT_ADDRESS);
+  CHECK(pt.begin() == MS8607_OK);
+  CHECK(rdwr_calls == 1);
+  CHECK(last_nmsgs == 1);
+  CHECK(last_msgs[0].addr == MS8607_PT_ADDRESS);
+  CHECK(last_msgs[0].len == 0);
+  CHECK(!(last_msgs[0].flags & I2C_M_RD));
+}
+
+static void test_begin_skips_probe_without_quick(void) {
+  reset_fakes();
+  funcs = I2C_FUNC_I2C;
+  Adafruit_MS8607_LinuxI2C pt("/dev/i2c-1", MS8607_PT_ADDRESS);
+  CHECK(pt.begin() == MS8607_OK);
+  CHECK(rdwr_calls == 0);
+}
+
+static void test_begin_failures(void) {
+  reset_fakes();
+  open_errno = ENOENT;
+  Adafruit_MS8607_LinuxI2C missing("/dev/i2c-9", MS8607_PT_ADDRESS);
+  CHECK(missing.begin() == MS8607_ERR_INVALID);
+  CHECK(missing.write(NULL, 0) == MS8607_ERR_INVALID);
+  CHECK(rdwr_calls == 0);
+
+  reset_fakes();
+  funcs = I2C_FUNC_SMBUS_QUICK;
+  Adafruit_MS8607_LinuxI2C smbus_only("/dev/i2c-1", MS8607_PT_ADDRESS);
+  CHECK(smbus_only.begin() == MS8607_ERR_INVALID);
+
+  reset_fakes();
+  funcs_errno = ENOTTY;
+  Adafruit_MS8607_LinuxI2C not_i2c("/dev/i2c-1", MS8607_PT_ADDRESS);
+  CHECK(not_i2c.begin() == MS8607_ERR_INVALID);
+
+  reset_fakes();
+  rdwr_errno = ENXIO;
+  Adafruit_MS8607_LinuxI2C absent("/dev/i2c-1", MS8607_PT_ADDRESS);
+  CHECK(absent.begin() == MS8607_ERR_NACK);
+}
+
+static void test_write_then_read_is_one_ioctl(void) {
+  reset_fakes();
+  Adafruit_MS8607_LinuxI2C pt("/dev/i2c-1", MS8607_PT_ADDRESS);
+  CHECK(pt.begin() == MS8607_OK);
+
+  uint8_t cmd = PROM_ADDRESS_READ_ADDRESS_0 + 2;
+  uint8_t word[2] = {0, 0};
+  rdwr_calls = 0;
+  CHECK(pt.write_then_read(&cmd, 1, word, 2) == MS8607_OK);
+  CHECK(rdwr_calls == 1);
+  CHECK(last_nmsgs == 2);
+  CHECK(last_msgs[0].addr == MS8607_PT_ADDRESS);
+  CHECK(last_msgs[0].flags == 0);
+  CHECK(last_msgs[0].len == 1);
+  CHECK(last_msgs[1].addr == MS8607_PT_ADDRESS);
+  CHECK(last_msgs[1].flags == I2C_M_RD);
+  CHECK(last_msgs[1].len == 2);
+  // C1 of the simulator's default calibration
+  CHECK((word[0] << 8 | word[1]) == 46372);
+}
+
+static void test_write_then_read_with_stop(void) {
+  reset_fakes();
+  Adafruit_MS8607_LinuxI2C hum("/dev/i2c-1", MS8607_HUM_ADDRESS);
+  CHECK(hum.begin() == MS8607_OK);
+
+  // the stop ends the first ioctl, and the read is a second one
+  uint8_t cmd = HSENSOR_READ_USER_REG_COMMAND, value = 0;
+  rdwr_calls = 0;
+  CHECK(hum.write_then_read(&cmd, 1, &value, 1, true) == MS8607_OK);
+  CHECK(rdwr_calls == 2);
+  CHECK(last_nmsgs == 1);
+  CHECK(last_msgs[0].flags == I2C_M_RD);
+  CHECK(last_msgs[0].len == 1);
+  CHECK(value == 0x02); // the reset value
+}
+
+static void test_errno_mapping(void) {
+  static const struct {
+    int error;
+    ms8607_status_t status;
+  } cases[] = {
+      {ENXIO, MS8607_ERR_NACK},       {EREMOTEIO, MS8607_ERR_NACK},
+      {ETIMEDOUT, MS8607_ERR_TIMEOUT}, {EINVAL, MS8607_ERR_INVALID},
+      {EIO, MS8607_ERR_BUS},          {EAGAIN, MS8607_ERR_BUS},
+  };
+  uint8_t cmd = HSENSOR_READ_USER_REG_COMMAND, value;
+
+  reset_fakes();
+  Adafruit_MS8607_LinuxI2C hum("/dev/i2c-1", MS8607_HUM_ADDRESS);
+  CHECK(hum.begin() == MS8607_OK);
+  for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+    rdwr_errno = cases[i].error;
+    CHECK(hum.write(&cmd, 1) == cases[i].status);
+    CHECK(hum.read(&value, 1) == cases[i].status);
+    CHECK(hum.write_then_read(&cmd, 1, &value, 1) == cases[i].status);
+  }
+}
+
+static void test_driver_over_transport(void) {
+  reset_fakes();
+  Adafruit_MS8607_LinuxI2C pt("/dev/i2c-1", MS8607_PT_ADDRESS);
+  Adafruit_MS8607_LinuxI2C hum("/dev/i2c-1", MS8607_HUM_ADDRESS);
+  Adafruit_MS8607 ms8607;
+
+  ms8607.setClock(&sim_clock);
+  CHECK(ms8607.begin(&pt, &hum));
+  CHECK(ms8607.read());
+  CHECK(ms8607.getTemperatureX100() == 2000);
+
+  // a NACK from the sensor reaches the driver as MS8607_ERR_NACK
+  ms8607_recovery_policy_t policy = {0, 0, 0};
+  ms8607.setRecoveryPolicy(&policy);
+  sim.injectFault(MS8607_ERR_NACK);
+  CHECK(!ms8607.read(false));
+  CHECK(ms8607.getStatus() == MS8607_ERR_NACK);
+}
+
+int main(void) {
+  test_begin_probes_address();
+  test_begin_skips_probe_without_quick();
+  test_begin_failures();
+  test_write_then_read_is_one_ioctl();
+  test_write_then_read_with_stop();
+  test_errno_mapping();
+  test_driver_over_transport();
+
+  if (failures) {
+    printf("linux_i2c_test: %d checks failed\n", failures);
+    return 1;
+  }
+  printf("linux_i2c_test: all checks passed\n");
+  return 0;
+}
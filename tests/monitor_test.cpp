@@ -0,0 +1,75 @@
+// Tests for how bus transactions are classified for the statistics. With
+// CXXFLAGS including -DMS8607_ENABLE_STATS the counts the driver keeps while
+// talking to a simulated MS8607 are checked as well.
+#include <Adafruit_MS8607.h>
+#include <Adafruit_MS8607_Simulator.h>
+
+static int failures = 0;
+
+#define CHECK(cond)                                                            \
+  do {                                                                         \
+    if (!(cond)) {                                                             \
+      printf("%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #cond);          \
+      failures++;                                                              \
+    }                                                                          \
+  } while (0)
+
+static ms8607_op_t classify(bool is_pt, uint16_t command, size_t len) {
+  uint8_t buffer[2] = {(uint8_t)(len > 1 ? command >> 8 : command),
+                       (uint8_t)command};
+  return ms8607_classify_op(is_pt, len ? buffer : NULL, len);
+}
+
+static void test_classify(void) {
+  CHECK(classify(true, PSENSOR_RESET_COMMAND, 1) == MS8607_OP_PT_COMMAND);
+  CHECK(classify(true, PSENSOR_READ_ADC, 1) == MS8607_OP_ADC_READ);
+  CHECK(classify(true, PROM_ADDRESS_READ_ADDRESS_0 + 2, 1) ==
+        MS8607_OP_PROM_READ);
+  CHECK(classify(false, HSENSOR_RESET_COMMAND, 1) == MS8607_OP_RH_COMMAND);
+  CHECK(classify(false, MS8607_I2C_NO_HOLD, 1) == MS8607_OP_RH_COMMAND);
+  CHECK(classify(false, MS8607_I2C_HOLD, 1) == MS8607_OP_RH_READ);
+  CHECK(classify(false, 0, 0) == MS8607_OP_RH_READ);
+  CHECK(classify(false, HSENSOR_READ_USER_REG_COMMAND, 1) ==
+        MS8607_OP_USER_REGISTER);
+  CHECK(classify(false, HSENSOR_READ_SERIAL_FIRST_8BYTES_COMMAND, 2) ==
+        MS8607_OP_SERIAL_READ);
+  CHECK(classify(false, HSENSOR_READ_SERIAL_LAST_6BYTES_COMMAND, 2) ==
+        MS8607_OP_SERIAL_READ);
+}
+
+#ifdef MS8607_ENABLE_STATS
+static void test_stats(void) {
+  Adafruit_MS8607_VirtualClock clock;
+  Adafruit_MS8607_Simulator sim(&clock);
+  Adafruit_MS8607 ms8607;
+  ms8607_stats_t stats;
+
+  ms8607.setClock(&clock);
+  CHECK(ms8607.begin(sim.getPTTransport(), sim.getHumidityTransport()));
+  ms8607.getStats(&stats);
+  CHECK(stats.ops[MS8607_OP_SERIAL_READ].count == 2);
+  CHECK(stats.ops[MS8607_OP_PROM_READ].count == 7);
+  CHECK(stats.ops[MS8607_OP_RH_COMMAND].count == 1);
+
+  ms8607.resetStats();
+  CHECK(ms8607.read());
+  ms8607.getStats(&stats);
+  CHECK(stats.ops[MS8607_OP_PT_COMMAND].count == 2);
+  CHECK(stats.ops[MS8607_OP_ADC_READ].count == 2);
+  CHECK(stats.ops[MS8607_OP_SERIAL_READ].count == 0);
+}
+#endif
+
+int main(void) {
+  test_classify();
+#ifdef MS8607_ENABLE_STATS
+  test_stats();
+#endif
+
+  if (failures) {
+    printf("monitor_test: %d checks failed\n", failures);
+    return 1;
+  }
+  printf("monitor_test: all checks passed\n");
+  return 0;
+}
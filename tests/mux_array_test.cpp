@@ -0,0 +1,151 @@
+// Tests for Adafruit_MS8607_MuxArray. Wire carries a model of a TCA9548A
+// with a simulated MS8607 on some of its channels.
+#include <Adafruit_MS8607.h>
+#include <Adafruit_MS8607_MuxArray.h>
+#include <Adafruit_MS8607_Simulator.h>
+
+static int failures = 0;
+
+#define CHECK(cond)                                                            \
+  do {                                                                         \
+    if (!(cond)) {                                                             \
+      printf("%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #cond);          \
+      failures++;                                                              \
+    }                                                                          \
+  } while (0)
+
+// readings of the simulator's default raw values
+#define SIM_TEMPERATURE 2000
+
+/** A multiplexer at TCA9548A_DEFAULT_ADDRESS */
+class Mux : public HostI2CDevices {
+public:
+  Mux() {
+    for (uint8_t i = 0; i < TCA9548A_CHANNELS; i++) {
+      channels[i] = NULL;
+    }
+  }
+
+  bool transfer(uint8_t address, const uint8_t *write_buffer,
+                size_t write_len, uint8_t *read_buffer, size_t read_len) {
+    if (address == TCA9548A_DEFAULT_ADDRESS) {
+      if (write_len == 1 && !read_len) {
+        mask = write_buffer[0];
+        if (switches < sizeof(masks)) {
+          masks[switches] = mask;
+        }
+        switches++;
+      }
+      return true;
+    }
+    // a sensor answers only through the one open channel
+    Adafruit_MS8607_Simulator *sim = NULL;
+    for (uint8_t i = 0; i < TCA9548A_CHANNELS; i++) {
+      if (mask & (1 << i) && channels[i]) {
+        if (sim) {
+          return false; // two sensors at the same address
+        }
+        sim = channels[i];
+      }
+    }
+    if (!sim || (address != MS8607_PT_ADDRESS &&
+                 address != MS8607_HUM_ADDRESS)) {
+      return false;
+    }
+    Adafruit_MS8607_Transport *dev = address == MS8607_PT_ADDRESS
+                                         ? sim->getPTTransport()
+                                         : sim->getHumidityTransport();
+    ms8607_status_t status;
+    if (write_len && read_len) {
+      status = dev->write_then_read(write_buffer, write_len, read_buffer,
+                                    read_len);
+    } else if (read_len) {
+      status = dev->read(read_buffer, read_len);
+    } else if (write_len) {
+      status = dev->write(write_buffer, write_len);
+    } else {
+      status = dev->begin();
+    }
+    return status == MS8607_OK;
+  }
+
+  Adafruit_MS8607_Simulator *channels[TCA9548A_CHANNELS];
+  uint8_t mask = 0;
+  uint8_t masks[64];
+  uint8_t switches = 0;
+};
+
+static void test_sensors_are_visited_in_channel_order(void) {
+  Adafruit_MS8607_VirtualClock clock;
+  Adafruit_MS8607_Simulator sim0(&clock), sim1(&clock);
+  Adafruit_MS8607_MuxArray<2> array(&Wire);
+  Mux mux;
+
+  Wire.devices = &mux;
+  mux.channels[5] = &sim0;
+  mux.channels[2] = &sim1;
+  CHECK(array.setRoute(0, TCA9548A_DEFAULT_ADDRESS, 5));
+  CHECK(array.setRoute(1, TCA9548A_DEFAULT_ADDRESS, 2));
+  CHECK(!array.setRoute(1, TCA9548A_DEFAULT_ADDRESS, TCA9548A_CHANNELS));
+  for (uint8_t i = 0; i < 2; i++) {
+    array.getSensor(i)->setClock(&clock);
+  }
+  CHECK(array.begin());
+  CHECK(mux.switches == 2);
+  CHECK(mux.masks[0] == 1 << 2);
+  CHECK(mux.masks[1] == 1 << 5);
+
+  // sensor 1, on the lower channel, is visited first, and each sensor's
+  // channel is opened once for each of its four steps
+  mux.switches = 0;
+  CHECK(array.read());
+  CHECK(array.ok(0) && array.ok(1));
+  CHECK(array.getSensor(0)->getTemperatureX100() == SIM_TEMPERATURE);
+  CHECK(array.getSensor(1)->getHumidityX100() > 0);
+  CHECK(mux.switches == 8);
+  for (uint8_t i = 0; i < mux.switches && i < 8; i++) {
+    CHECK(mux.masks[i] == (i % 2 ? 1 << 5 : 1 << 2));
+  }
+  CHECK(array.channelSwitches() == 10);
+  Wire.devices = NULL;
+}
+
+static void test_failing_sensor_does_not_block_others(void) {
+  Adafruit_MS8607_VirtualClock clock;
+  Adafruit_MS8607_Simulator sim0(&clock), sim2(&clock);
+  Adafruit_MS8607_MuxArray<3> array(&Wire);
+  ms8607_recovery_policy_t no_recovery = {0, 0, 0};
+  Mux mux;
+
+  // nothing is on sensor 1's channel
+  Wire.devices = &mux;
+  mux.channels[0] = &sim0;
+  mux.channels[2] = &sim2;
+  for (uint8_t i = 0; i < 3; i++) {
+    array.getSensor(i)->setClock(&clock);
+  }
+  CHECK(!array.begin());
+  array.getSensor(2)->setRecoveryPolicy(&no_recovery);
+
+  CHECK(array.read());
+  CHECK(array.ok(0) && !array.ok(1) && array.ok(2));
+
+  // sensor 2's temperature result is lost
+  sim2.injectFault(MS8607_ERR_BUS, 1, 1);
+  CHECK(!array.read());
+  CHECK(array.ok(0) && !array.ok(2));
+  CHECK(array.getSensor(0)->getHumidityX100() > 0);
+  Wire.devices = NULL;
+}
+
+int main(void) {
+  test_sensors_are_visited_in_channel_order();
+  test_failing_sensor_does_not_block_others();
+
+  if (failures) {
+    printf("mux_array_test: %d checks failed\n", failures);
+    return 1;
+  }
+  printf("mux_array_test: all checks passed\n");
+  return 0;
+}
@@ -0,0 +1,140 @@
+// Tests for Adafruit_MS8607_Pipeline, reading simulated MS8607s.
+#include <Adafruit_MS8607.h>
+#include <Adafruit_MS8607_Pipeline.h>
+#include <Adafruit_MS8607_Simulator.h>
+
+static int failures = 0;
+
+#define CHECK(cond)                                                            \
+  do {                                                                         \
+    if (!(cond)) {                                                             \
+      printf("%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #cond);          \
+      failures++;                                                              \
+    }                                                                          \
+  } while (0)
+
+// readings of the simulator's default raw values
+#define SIM_TEMPERATURE 2000
+#define SIM_PRESSURE 110002
+
+/** Records the sensors selected, and can refuse to select one */
+struct selections {
+  uint8_t order[32];
+  uint8_t count;
+  int16_t unreachable; // sensor that cannot be selected, or -1
+};
+
+static bool select_sensor(uint8_t index, void *context) {
+  selections *s = (selections *)context;
+  if (s->count < sizeof(s->order)) {
+    s->order[s->count++] = index;
+  }
+  return index != s->unreachable;
+}
+
+static void test_conversions_are_interleaved(void) {
+  Adafruit_MS8607_VirtualClock clock;
+  Adafruit_MS8607_Simulator sim0(&clock), sim1(&clock);
+  Adafruit_MS8607 ms0, ms1;
+  Adafruit_MS8607_Pipeline<3> pipeline;
+  selections s = {{0}, 0, -1};
+
+  ms0.setClock(&clock);
+  ms1.setClock(&clock);
+  CHECK(ms0.begin(sim0.getPTTransport(), sim0.getHumidityTransport()));
+  CHECK(ms1.begin(sim1.getPTTransport(), sim1.getHumidityTransport()));
+  // slot 1 is left empty
+  CHECK(pipeline.setSensor(0, &ms0));
+  CHECK(pipeline.setSensor(2, &ms1));
+  CHECK(!pipeline.setSensor(3, &ms1));
+  pipeline.setSelectCallback(select_sensor, &s);
+
+  uint32_t start_us = clock.micros();
+  CHECK(pipeline.read());
+  CHECK(pipeline.ok(0) && !pipeline.ok(1) && pipeline.ok(2));
+  CHECK(ms0.getTemperatureX100() == SIM_TEMPERATURE);
+  CHECK(ms1.getPressureX100() == SIM_PRESSURE);
+  CHECK(ms1.getHumidityX100() > 0);
+
+  // each sensor is selected to start its temperature conversion, for each
+  // of the three results, and in turn as the conversions finish
+  const uint8_t expected[] = {0, 2, 0, 2, 0, 2, 0, 2};
+  CHECK(s.count == sizeof(expected));
+  for (uint8_t i = 0; i < s.count && i < sizeof(expected); i++) {
+    CHECK(s.order[i] == expected[i]);
+  }
+  // the conversions overlap, so both take little longer than one
+  uint32_t one_us =
+      2 * ms0.getPTConversionTime() + ms0.getHumidityConversionTime();
+  CHECK(clock.micros() - start_us < one_us + one_us / 4);
+}
+
+static void test_failing_sensor_does_not_block_others(void) {
+  Adafruit_MS8607_VirtualClock clock;
+  Adafruit_MS8607_Simulator sim0(&clock), sim1(&clock);
+  Adafruit_MS8607 ms0, ms1;
+  Adafruit_MS8607_Pipeline<2> pipeline;
+  selections s = {{0}, 0, 0};
+  ms8607_recovery_policy_t no_recovery = {0, 0, 0};
+
+  ms0.setClock(&clock);
+  ms1.setClock(&clock);
+  CHECK(ms0.begin(sim0.getPTTransport(), sim0.getHumidityTransport()));
+  CHECK(ms1.begin(sim1.getPTTransport(), sim1.getHumidityTransport()));
+  ms1.setRecoveryPolicy(&no_recovery);
+  pipeline.setSensor(0, &ms0);
+  pipeline.setSensor(1, &ms1);
+  pipeline.setSelectCallback(select_sensor, &s);
+
+  // sensor 0 cannot be selected
+  CHECK(!pipeline.read());
+  CHECK(!pipeline.ok(0));
+  CHECK(pipeline.ok(1));
+  CHECK(ms1.getTemperatureX100() == SIM_TEMPERATURE);
+
+  // sensor 1 fails its pressure result
+  s.unreachable = -1;
+  sim1.injectFault(MS8607_ERR_BUS, 1, 3);
+  CHECK(!pipeline.read());
+  CHECK(pipeline.ok(0));
+  CHECK(!pipeline.ok(1));
+  CHECK(ms0.getHumidityX100() > 0);
+
+  CHECK(pipeline.read());
+  CHECK(pipeline.ok(0) && pipeline.ok(1));
+}
+
+static void test_sensors_with_their_own_clocks(void) {
+  Adafruit_MS8607_VirtualClock clock0, clock1;
+  Adafruit_MS8607_Simulator sim0(&clock0), sim1(&clock1);
+  Adafruit_MS8607 ms0, ms1;
+  Adafruit_MS8607_Pipeline<2> pipeline;
+
+  // a second clock far ahead of the first: each conversion is still waited
+  // for on its sensor's clock
+  clock1.advance(1000000);
+  ms0.setClock(&clock0);
+  ms1.setClock(&clock1);
+  CHECK(ms0.begin(sim0.getPTTransport(), sim0.getHumidityTransport()));
+  CHECK(ms1.begin(sim1.getPTTransport(), sim1.getHumidityTransport()));
+  pipeline.setSensor(0, &ms0);
+  pipeline.setSensor(1, &ms1);
+
+  CHECK(pipeline.read());
+  CHECK(pipeline.ok(0) && pipeline.ok(1));
+  CHECK(ms0.getTemperatureX100() == SIM_TEMPERATURE);
+  CHECK(ms1.getTemperatureX100() == SIM_TEMPERATURE);
+}
+
+int main(void) {
+  test_conversions_are_interleaved();
+  test_failing_sensor_does_not_block_others();
+  test_sensors_with_their_own_clocks();
+
+  if (failures) {
+    printf("pipeline_test: %d checks failed\n", failures);
+    return 1;
+  }
+  printf("pipeline_test: all checks passed\n");
+  return 0;
+}
@@ -0,0 +1,174 @@
+// Tests for Adafruit_MS8607_Replay. Captures are written with the
+// ms8607_capture_* functions from raw values that a simulated MS8607 also
+// gives the driver live, so a replay must reproduce the live readings.
+#include <Adafruit_MS8607.h>
+#include <Adafruit_MS8607_Replay.h>
+#include <Adafruit_MS8607_Simulator.h>
+
+static int failures = 0;
+
+#define CHECK(cond)                                                            \
+  do {                                                                         \
+    if (!(cond)) {                                                             \
+      printf("%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #cond);          \
+      failures++;                                                              \
+    }                                                                          \
+  } while (0)
+
+/** A capture written to memory */
+class CaptureBuffer : public Print {
+public:
+  size_t write(uint8_t c) {
+    if (len >= sizeof(data)) {
+      return 0;
+    }
+    data[len++] = c;
+    return 1;
+  }
+  uint8_t data[256];
+  size_t len = 0;
+};
+
+/** Raw values of one read, and the readings they give */
+struct reading {
+  uint32_t raw_temp, raw_pressure;
+  uint16_t raw_humidity;
+  int32_t temperature, pressure, humidity;
+};
+
+static reading readings[] = {
+    {6465444, 8077636, 0x6A50, 0, 0, 0},
+    {6466444, 8077136, 0x6A90, 0, 0, 0},
+    {6467444, 8076636, 0x6AD0, 0, 0, 0},
+    {6468444, 8076136, 0x6B10, 0, 0, 0},
+};
+
+static void read_live(void) {
+  Adafruit_MS8607_VirtualClock clock;
+  Adafruit_MS8607_Simulator sim(&clock);
+  Adafruit_MS8607 ms8607;
+
+  ms8607.setClock(&clock);
+  CHECK(ms8607.begin(sim.getPTTransport(), sim.getHumidityTransport()));
+  for (size_t i = 0; i < sizeof(readings) / sizeof(readings[0]); i++) {
+    reading *r = &readings[i];
+    sim.setRawValues(r->raw_pressure, r->raw_temp, r->raw_humidity);
+    CHECK(ms8607.read());
+    r->temperature = ms8607.getTemperatureX100();
+    r->pressure = ms8607.getPressureX100();
+    r->humidity = ms8607.getHumidityX100();
+  }
+}
+
+static void write_header(CaptureBuffer *out) {
+  Adafruit_MS8607_VirtualClock clock;
+  Adafruit_MS8607_Simulator sim(&clock);
+  ms8607_calibration_t calibration;
+
+  CHECK(ms8607_read_calibration(sim.getPTTransport(), &calibration) ==
+        MS8607_OK);
+  CHECK(ms8607_capture_header(out, &calibration));
+}
+
+static void test_replay_follows_capture(void) {
+  CaptureBuffer capture;
+  const reading *r = readings;
+
+  // a read with humidity, one without, one of humidity alone, then one
+  // with humidity again
+  write_header(&capture);
+  CHECK(ms8607_capture_pt_humidity(&capture, 1000, r[0].raw_temp,
+                                   r[0].raw_pressure, 1100,
+                                   r[0].raw_humidity));
+  CHECK(ms8607_capture_pt(&capture, 2000, r[1].raw_temp, r[1].raw_pressure));
+  CHECK(ms8607_capture_humidity(&capture, 3000, r[2].raw_humidity));
+  CHECK(ms8607_capture_pt_humidity(&capture, 4000, r[3].raw_temp,
+                                   r[3].raw_pressure, 4100,
+                                   r[3].raw_humidity));
+
+  Adafruit_MS8607_VirtualClock clock;
+  Adafruit_MS8607_Replay replay(capture.data, capture.len);
+  Adafruit_MS8607 ms8607;
+  uint16_t raw;
+
+  CHECK(replay.isValid());
+  ms8607.setClock(&clock);
+  CHECK(ms8607.begin(replay.getPTTransport(), replay.getHumidityTransport()));
+
+  CHECK(replay.hasHumidity());
+  CHECK(ms8607.read(replay.hasHumidity()));
+  CHECK(ms8607.getTemperatureX100() == r[0].temperature);
+  CHECK(ms8607.getPressureX100() == r[0].pressure);
+  CHECK(ms8607.getHumidityX100() == r[0].humidity);
+  CHECK(replay.getPTTime() == 1000);
+  CHECK(replay.getHumidityTime() == 1100);
+
+  CHECK(!replay.hasHumidity());
+  CHECK(ms8607.read(replay.hasHumidity()));
+  CHECK(ms8607.getTemperatureX100() == r[1].temperature);
+  CHECK(ms8607.getPressureX100() == r[1].pressure);
+  CHECK(replay.getPTTime() == 2000);
+
+  CHECK(ms8607.startHumidityConversion());
+  CHECK(ms8607.readHumidityConversion(&raw));
+  CHECK(raw == r[2].raw_humidity);
+  CHECK(replay.getHumidityTime() == 3000);
+
+  CHECK(replay.hasHumidity());
+  CHECK(!replay.atEnd());
+  CHECK(ms8607.read(replay.hasHumidity()));
+  CHECK(ms8607.getTemperatureX100() == r[3].temperature);
+  CHECK(ms8607.getHumidityX100() == r[3].humidity);
+  CHECK(replay.getHumidityTime() == 4100);
+  CHECK(replay.atEnd());
+  CHECK(!replay.hasHumidity());
+}
+
+static void test_skipped_humidity_stays_in_step(void) {
+  CaptureBuffer capture;
+  const reading *r = readings;
+
+  write_header(&capture);
+  for (int i = 0; i < 2; i++) {
+    CHECK(ms8607_capture_pt_humidity(&capture, 0, r[i].raw_temp,
+                                     r[i].raw_pressure, 0,
+                                     r[i].raw_humidity));
+  }
+
+  Adafruit_MS8607_VirtualClock clock;
+  Adafruit_MS8607_Replay replay(capture.data, capture.len);
+  Adafruit_MS8607 ms8607;
+
+  ms8607.setClock(&clock);
+  CHECK(ms8607.begin(replay.getPTTransport(), replay.getHumidityTransport()));
+  // leaving out the first read's humidity does not shift the second read
+  CHECK(ms8607.read(false));
+  CHECK(ms8607.read());
+  CHECK(ms8607.getTemperatureX100() == r[1].temperature);
+  CHECK(ms8607.getHumidityX100() == r[1].humidity);
+  CHECK(replay.atEnd());
+}
+
+static void test_rejects_other_versions(void) {
+  CaptureBuffer capture;
+
+  write_header(&capture);
+  capture.data[4] = MS8607_CAPTURE_VERSION - 1;
+  Adafruit_MS8607_Replay replay(capture.data, capture.len);
+  CHECK(!replay.isValid());
+  CHECK(replay.getPTTransport()->begin() == MS8607_ERR_INVALID);
+}
+
+int main(void) {
+  read_live();
+  test_replay_follows_capture();
+  test_skipped_humidity_stays_in_step();
+  test_rejects_other_versions();
+
+  if (failures) {
+    printf("replay_test: %d checks failed\n", failures);
+    return 1;
+  }
+  printf("replay_test: all checks passed\n");
+  return 0;
+}
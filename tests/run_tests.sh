@@ -0,0 +1,31 @@
+#!/bin/bash
+# Build and run the host tests. Each tests/*_test.cpp is linked with the
+# library's sources against the minimal Arduino headers in tests/host, so
+# only a C++ compiler is needed. async_test.cpp needs C++20 coroutines and
+# is built with CXX20FLAGS instead, which compiles the library as C++20 too.
+#
+# Usage: tests/run_tests.sh
+
+set -e
+
+ROOT=$(cd "$(dirname "$0")/.." && pwd)
+BUILD=${BUILD:-$(mktemp -d)}
+CXX=${CXX:-g++}
+CXXFLAGS=${CXXFLAGS:--std=c++11 -g -Wall -Wextra}
+CXX20FLAGS=${CXX20FLAGS:--std=c++20 -g -Wall -Wextra}
+
+mkdir -p "$BUILD"
+SOURCES="$ROOT/Adafruit_MS8607*.cpp $ROOT/tests/host/*.cpp"
+
+failed=0
+for test in "$ROOT"/tests/*_test.cpp; do
+  name=$(basename "$test" .cpp)
+  flags=$CXXFLAGS
+  if [ "$name" = async_test ]; then
+    flags=$CXX20FLAGS
+  fi
+  $CXX $flags -I"$ROOT/tests/host" -I"$ROOT" "$test" $SOURCES \
+    -o "$BUILD/$name"
+  "$BUILD/$name" || failed=1
+done
+exit $failed
@@ -0,0 +1,175 @@
+// Tests for Adafruit_MS8607_Scheduler, ticked from the same virtual clock
+// as a simulated MS8607 so its bus time delays the conversions as it would
+// on a real bus.
+#include <Adafruit_MS8607.h>
+#include <Adafruit_MS8607_Scheduler.h>
+#include <Adafruit_MS8607_Simulator.h>
+
+static int failures = 0;
+
+#define CHECK(cond)                                                            \
+  do {                                                                         \
+    if (!(cond)) {                                                             \
+      printf("%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #cond);          \
+      failures++;                                                              \
+    }                                                                          \
+  } while (0)
+
+#define PERIOD_US 50000 ///< Sample period long enough for OSR 4096
+#define TICK_US 100     ///< Time between ticks
+
+// readings of the simulator's default raw values
+#define SIM_TEMPERATURE 20.0f
+#define SIM_PRESSURE 1100.02f
+
+/** Tick the scheduler for a while, collecting the samples it makes */
+static uint8_t run(Adafruit_MS8607_Scheduler *scheduler,
+                   Adafruit_MS8607_VirtualClock *clock, uint32_t duration_us,
+                   ms8607_sample_t *samples, uint8_t max_samples) {
+  uint8_t count = 0;
+  uint32_t start_us = clock->micros();
+
+  while (clock->micros() - start_us < duration_us) {
+    scheduler->tick(clock->micros());
+    clock->advance(TICK_US);
+    while (count < max_samples && scheduler->read(&samples[count])) {
+      count++;
+    }
+  }
+  return count;
+}
+
+static bool near(float a, float b) { return a - b < 0.01f && b - a < 0.01f; }
+
+static void test_cadence(ms8607_pressure_resolution_t resolution,
+                         uint32_t period_us) {
+  Adafruit_MS8607_VirtualClock clock;
+  Adafruit_MS8607_Simulator sim(&clock);
+  Adafruit_MS8607 ms8607;
+  Adafruit_MS8607_Scheduler scheduler(&ms8607);
+  ms8607_sample_t samples[16];
+
+  ms8607.setClock(&clock);
+  CHECK(ms8607.begin(sim.getPTTransport(), sim.getHumidityTransport()));
+  CHECK(ms8607.setPressureResolution(resolution));
+  uint32_t start_us = clock.micros();
+  CHECK(scheduler.start(period_us, start_us));
+
+  uint8_t count = run(&scheduler, &clock, 10 * period_us, samples, 16);
+  CHECK(count == 10);
+  CHECK(scheduler.errors() == 0);
+  CHECK(scheduler.missedDeadlines() == 0);
+  CHECK(scheduler.overruns() == 0);
+  for (uint8_t i = 0; i < count; i++) {
+    CHECK(samples[i].timestamp_us == start_us + i * period_us);
+    // each quantity is stamped within its slot, in the order converted
+    uint32_t slot_us = samples[i].timestamp_us;
+    CHECK(samples[i].temperature_us - slot_us < period_us);
+    CHECK(samples[i].pressure_us - slot_us < period_us);
+    CHECK(samples[i].humidity_us - slot_us < period_us);
+    CHECK(samples[i].temperature_us < samples[i].pressure_us);
+    CHECK(samples[i].pressure_us < samples[i].humidity_us);
+    CHECK(near(samples[i].temperature, SIM_TEMPERATURE));
+    CHECK(near(samples[i].pressure, SIM_PRESSURE));
+    CHECK(samples[i].humidity > 0);
+  }
+}
+
+static void test_missed_deadlines(void) {
+  Adafruit_MS8607_VirtualClock clock;
+  Adafruit_MS8607_Simulator sim(&clock);
+  Adafruit_MS8607 ms8607;
+  Adafruit_MS8607_Scheduler scheduler(&ms8607);
+  ms8607_sample_t samples[16];
+
+  ms8607.setClock(&clock);
+  CHECK(ms8607.begin(sim.getPTTransport(), sim.getHumidityTransport()));
+  uint32_t start_us = clock.micros();
+  CHECK(scheduler.start(PERIOD_US, start_us));
+  CHECK(run(&scheduler, &clock, PERIOD_US, samples, 16) == 1);
+
+  // not ticked for a little over two periods: the two slots that passed
+  // are missed, and sampling goes on from the next one, which still ends
+  // before the slot after it
+  clock.advance(2 * PERIOD_US + PERIOD_US / 10);
+  uint8_t count = run(&scheduler, &clock, 2 * PERIOD_US, samples, 16);
+  CHECK(scheduler.missedDeadlines() == 2);
+  CHECK(count == 2);
+  CHECK(scheduler.errors() == 0);
+  if (count) {
+    CHECK((samples[count - 1].timestamp_us - start_us) % PERIOD_US == 0);
+  }
+}
+
+static void test_without_humidity(void) {
+  Adafruit_MS8607_VirtualClock clock;
+  Adafruit_MS8607_Simulator sim(&clock);
+  Adafruit_MS8607 ms8607;
+  Adafruit_MS8607_Scheduler scheduler(&ms8607);
+  ms8607_sample_t samples[16];
+  uint32_t pt_us;
+
+  ms8607.setClock(&clock);
+  CHECK(ms8607.begin(sim.getPTTransport(), sim.getHumidityTransport()));
+  CHECK(ms8607.setPressureResolution(MS8607_PRESSURE_RESOLUTION_OSR_1024));
+  pt_us = 2 * ms8607.getPTConversionTime();
+  // a period only long enough for the pressure & temperature conversions
+  CHECK(!scheduler.start(pt_us + 1000, clock.micros()));
+  CHECK(scheduler.start(pt_us + 1000, clock.micros(), false));
+
+  sim.resetCounters();
+  uint8_t count = run(&scheduler, &clock, 5 * (pt_us + 1000), samples, 16);
+  CHECK(count == 5);
+  CHECK(scheduler.errors() == 0);
+  // two conversion commands and two ADC reads per sample
+  CHECK(sim.getTransactions() == 4u * count);
+  for (uint8_t i = 0; i < count; i++) {
+    CHECK(near(samples[i].pressure, SIM_PRESSURE));
+    CHECK(samples[i].humidity == 0);
+    CHECK(samples[i].humidity_us == samples[i].timestamp_us);
+  }
+}
+
+#ifndef MS8607_NO_UNIFIED_SENSOR
+static void test_event_timestamps(void) {
+  Adafruit_MS8607_VirtualClock clock;
+  Adafruit_MS8607_Simulator sim(&clock);
+  Adafruit_MS8607 ms8607;
+  Adafruit_MS8607_Scheduler scheduler(&ms8607);
+  sensors_event_t temp, pressure, humidity;
+
+  ms8607.setClock(&clock);
+  CHECK(ms8607.begin(sim.getPTTransport(), sim.getHumidityTransport()));
+  int32_t start_ms = (int32_t)clock.millis();
+  CHECK(scheduler.start(PERIOD_US, clock.micros()));
+  while (!scheduler.available()) {
+    scheduler.tick(clock.micros());
+    clock.advance(TICK_US);
+  }
+
+  // each event has its own conversion's time, not the slot's
+  CHECK(scheduler.readEvents(&temp, &pressure, &humidity, 1) == 1);
+  CHECK(start_ms < temp.timestamp);
+  CHECK(temp.timestamp < pressure.timestamp);
+  CHECK(pressure.timestamp < humidity.timestamp);
+  CHECK(humidity.timestamp < (int32_t)clock.millis());
+}
+#endif
+
+int main(void) {
+  test_cadence(MS8607_PRESSURE_RESOLUTION_OSR_4096, PERIOD_US);
+  test_cadence(MS8607_PRESSURE_RESOLUTION_OSR_1024, 25000);
+  test_cadence(MS8607_PRESSURE_RESOLUTION_OSR_256, 25000);
+  test_missed_deadlines();
+  test_without_humidity();
+#ifndef MS8607_NO_UNIFIED_SENSOR
+  test_event_timestamps();
+#endif
+
+  if (failures) {
+    printf("scheduler_test: %d checks failed\n", failures);
+    return 1;
+  }
+  printf("scheduler_test: all checks passed\n");
+  return 0;
+}
@@ -0,0 +1,45 @@
+#!/bin/bash
+# Report the flash and RAM taken by each part of the MS8607 driver, by
+# building examples/footprint with different options and comparing the
+# sizes against a sketch that does not use the driver.
+#
+# Usage: tools/footprint.sh [FQBN]
+#
+# Needs arduino-cli with the board's core, Adafruit BusIO and Adafruit
+# Unified Sensor installed. The default board is an Uno, with 32 KB of flash.
+
+set -e
+
+FQBN=${1:-arduino:avr:uno}
+ROOT=$(cd "$(dirname "$0")/.." && pwd)
+SKETCH=$ROOT/examples/footprint
+
+# build with the given compiler flags and print "flash ram" in bytes
+measure() {
+  arduino-cli compile --clean --fqbn "$FQBN" --library "$ROOT" \
+    --build-property "compiler.cpp.extra_flags=$1" "$SKETCH" |
+    sed -n -e 's/^Sketch uses \([0-9]*\) bytes.*/\1/p' \
+      -e 's/^Global variables use \([0-9]*\) bytes.*/\1/p' |
+    tr '\n' ' '
+}
+
+PROFILES=(
+  "Integer read, size-optimized|-DMS8607_NO_FLOAT"
+  "Integer read, default build|"
+  "Float read, no Unified Sensor|-DMS8607_NO_UNIFIED_SENSOR -DFOOTPRINT_FLOAT"
+  "Unified Sensor getEvent()|-DFOOTPRINT_UNIFIED_SENSOR"
+  "Adafruit_MS8607_Fixed<>, integer|-DMS8607_NO_FLOAT -DFOOTPRINT_FIXED"
+)
+
+read -r base_flash base_ram <<<"$(measure -DFOOTPRINT_EMPTY)"
+
+echo "MS8607 footprint on $FQBN, over a sketch without the driver"
+echo "(${base_flash} bytes flash, ${base_ram} bytes RAM)"
+echo
+printf "%-36s %8s %8s\n" "Configuration" "Flash" "RAM"
+for profile in "${PROFILES[@]}"; do
+  name=${profile%%|*}
+  flags=${profile#*|}
+  read -r flash ram <<<"$(measure "$flags")"
+  printf "%-36s %8d %8d\n" "$name" $((flash - base_flash)) $((ram - base_ram))
+done
@@ -0,0 +1,114 @@
+#!/usr/bin/env python3
+"""Decode an MS8607 binary log written by Adafruit_MS8607_LogWriter.
+
+Prints the samples as CSV, with temperature in degrees C, pressure in hPa and
+relative humidity in %rH. With --stats, prints the size of the log per sample
+instead, compared with the same samples as CSV.
+
+Usage: tools/ms8607_log.py [--stats] FILE
+"""
+
+import argparse
+import sys
+
+MAGIC = b"MS8L"
+VERSION = 1
+
+
+class Truncated(Exception):
+    """The log ends part way through a record"""
+
+
+def varint(data, offset):
+    """Read an unsigned LEB128 varint, returning it and the next offset."""
+    value = shift = 0
+    while True:
+        if offset >= len(data):
+            raise Truncated()
+        byte = data[offset]
+        offset += 1
+        value |= (byte & 0x7F) << shift
+        shift += 7
+        if not byte & 0x80:
+            return value, offset
+
+
+def signed(data, offset):
+    """Read a zigzag encoded signed varint."""
+    value, offset = varint(data, offset)
+    return (value >> 1) ^ -(value & 1), offset
+
+
+def decode(data):
+    """Yield (time_ms, temperature, pressure, humidity, keyframe) tuples, with
+    values in hundredths. A record cut short at the end is dropped."""
+    if data[:4] != MAGIC:
+        raise ValueError("not an MS8607 log")
+    if data[4] != VERSION:
+        raise ValueError("unsupported log version %d" % data[4])
+    offset = 5
+    time_ms = None
+    values = [0, 0, 0]
+    try:
+        while offset < len(data):
+            delta, offset = varint(data, offset)
+            keyframe = delta == 0
+            if keyframe:
+                time_ms, offset = varint(data, offset)
+            elif time_ms is None:
+                raise ValueError("log does not start with a keyframe")
+            else:
+                time_ms = (time_ms + delta - 1) & 0xFFFFFFFF
+            for i in range(3):
+                value, offset = signed(data, offset)
+                if not keyframe:
+                    # sums wrap at 32 bits, as the encoder's differences do
+                    value = (values[i] + value + 2**31) % 2**32 - 2**31
+                values[i] = value
+            yield (time_ms, values[0], values[1], values[2], keyframe)
+    except Truncated:
+        return
+
+
+def csv_line(sample):
+    time_ms, temperature, pressure, humidity, _ = sample
+    return "%d,%.2f,%.2f,%.2f\n" % (
+        time_ms,
+        temperature / 100,
+        pressure / 100,
+        humidity / 100,
+    )
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Decode an MS8607 binary log")
+    parser.add_argument("file", help="log to decode")
+    parser.add_argument(
+        "--stats", action="store_true", help="print the size per sample"
+    )
+    args = parser.parse_args()
+
+    with open(args.file, "rb") as f:
+        data = f.read()
+    samples = list(decode(data))
+
+    if not args.stats:
+        sys.stdout.write("time_ms,temperature,pressure,humidity\n")
+        for sample in samples:
+            sys.stdout.write(csv_line(sample))
+        return
+
+    count = len(samples)
+    if not count:
+        print("no samples")
+        return
+    csv_bytes = sum(len(csv_line(sample)) for sample in samples)
+    print("samples:      %d" % count)
+    print("keyframes:    %d" % sum(1 for sample in samples if sample[4]))
+    print("log bytes:    %d, %.2f per sample" % (len(data), len(data) / count))
+    print("CSV bytes:    %d, %.2f per sample" % (csv_bytes, csv_bytes / count))
+    print("compression:  %.1fx" % (csv_bytes / len(data)))
+
+
+if __name__ == "__main__":
+    main()
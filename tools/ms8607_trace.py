@@ -0,0 +1,121 @@
+#!/usr/bin/env python3
+"""Decode an MS8607 bus trace.
+
+Reads the lines printed by Adafruit_MS8607::dumpTrace() from a file or
+stdin. Other lines, such as the rest of a serial log, are skipped. With
+--binary, reads raw ms8607_trace_entry_t structs instead, e.g. copied out of
+memory with a debugger: 8 bytes each, little-endian.
+
+Usage: tools/ms8607_trace.py [--binary] [FILE]
+"""
+
+import argparse
+import re
+import struct
+import sys
+
+PT_ADDRESS = 0x76
+HUM_ADDRESS = 0x40
+HUMIDITY_FLAG = 0x80
+
+STATUS = ["OK", "NACK", "TIMEOUT", "BUS", "INVALID", "CRC"]
+OSR = [256, 512, 1024, 2048, 4096, 8192]
+
+LINE = re.compile(
+    r"MS8607 ([0-9A-Fa-f]{8}) ([0-9A-Fa-f]{2})([0-9A-Fa-f]{2}) "
+    r"([0-9A-Fa-f]{2}) ([0-9A-Fa-f]{2})"
+)
+
+
+def describe(humidity, command, second, write_len):
+    """Name the operation from the die and the bytes written."""
+    if write_len == 0:
+        return "read result" if humidity else "read"
+    if not humidity:
+        if command == 0x1E:
+            return "reset"
+        if command == 0x00:
+            return "ADC read"
+        if command & 0xF0 == 0xA0:
+            return "PROM read word %d" % ((command & 0x0E) >> 1)
+        if command & 0xE1 == 0x40 and (command & 0x0F) >> 1 < len(OSR):
+            kind = "D2 temperature" if command & 0x10 else "D1 pressure"
+            return "convert %s OSR %d" % (kind, OSR[(command & 0x0F) >> 1])
+    else:
+        names = {
+            0xFE: "reset",
+            0xE5: "measure, hold",
+            0xF5: "measure, no hold",
+            0xE6: "write user register",
+            0xE7: "read user register",
+        }
+        if command in names:
+            return names[command]
+        if command == 0xFA and second == 0x0F:
+            return "read serial number, first part"
+        if command == 0xFC and second == 0xC9:
+            return "read serial number, last part"
+    if write_len > 1:
+        return "unknown command 0x%02X%02X" % (command, second)
+    return "unknown command 0x%02X" % command
+
+
+def entries_from_text(stream):
+    for line in stream:
+        match = LINE.search(line)
+        if match:
+            yield tuple(int(field, 16) for field in match.groups())
+
+
+def entries_from_binary(data):
+    for offset in range(0, len(data) - 7, 8):
+        yield struct.unpack_from("<IBBBB", data, offset)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Decode an MS8607 bus trace")
+    parser.add_argument("file", nargs="?", help="trace to decode, or stdin")
+    parser.add_argument(
+        "--binary", action="store_true", help="read raw 8-byte entries"
+    )
+    args = parser.parse_args()
+
+    if args.binary:
+        if args.file:
+            with open(args.file, "rb") as f:
+                data = f.read()
+        else:
+            data = sys.stdin.buffer.read()
+        entries = entries_from_binary(data)
+    elif args.file:
+        entries = entries_from_text(open(args.file))
+    else:
+        entries = entries_from_text(sys.stdin)
+
+    print(
+        "%12s %10s  %-4s %-36s %5s %4s  %s"
+        % ("time (us)", "delta", "addr", "operation", "write", "read", "status")
+    )
+    previous = None
+    for time_us, command, second, lengths, status in entries:
+        humidity = bool(status & HUMIDITY_FLAG)
+        status &= ~HUMIDITY_FLAG
+        write_len, read_len = lengths >> 4, lengths & 0x0F
+        delta = "" if previous is None else "+%d" % ((time_us - previous) & 0xFFFFFFFF)
+        previous = time_us
+        print(
+            "%12d %10s  0x%02X %-36s %5d %4d  %s"
+            % (
+                time_us,
+                delta,
+                HUM_ADDRESS if humidity else PT_ADDRESS,
+                describe(humidity, command, second, write_len),
+                write_len,
+                read_len,
+                STATUS[status] if status < len(STATUS) else "status %d" % status,
+            )
+        )
+
+
+if __name__ == "__main__":
+    main()